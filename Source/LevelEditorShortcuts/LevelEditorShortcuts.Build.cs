@@ -20,7 +20,8 @@ public class LevelEditorShortcuts : ModuleRules
 		{
 			"UnrealEd",
 			"EditorFramework",
-			"LevelEditor"
+			"LevelEditor",
+			"Landscape"
 		});
 	}
 }
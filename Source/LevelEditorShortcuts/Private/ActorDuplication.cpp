@@ -0,0 +1,343 @@
+// ActorDuplication.cpp
+// Duplicate-in-place paths, plus LevelEditorShortcuts.BenchmarkDuplicateInPlace to compare them.
+
+#include "ActorDuplication.h"
+#include "LevelEditorShortcutsLog.h"
+#include "Editor.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/PointLight.h"
+#include "Engine/SpotLight.h"
+#include "Engine/RectLight.h"
+#include "Engine/DecalActor.h"
+#include "Engine/Selection.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+#include "Editor/GroupActor.h"
+#include "ActorEditorUtils.h"
+#include "ScopedTransaction.h"
+#include "Editor/Transactor.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+FScopedAddedActorCapture::FScopedAddedActorCapture()
+{
+	if (GEngine)
+	{
+		ActorAddedHandle = GEngine->OnLevelActorAdded().AddLambda([this](AActor* Actor)
+		{
+			AddedActors.Add(Actor);
+		});
+	}
+}
+
+FScopedAddedActorCapture::~FScopedAddedActorCapture()
+{
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+	}
+}
+
+TArray<AActor*> FScopedAddedActorCapture::GetActors() const
+{
+	TArray<AActor*> Actors;
+	Actors.Reserve(AddedActors.Num());
+	for (const TWeakObjectPtr<AActor>& Actor : AddedActors)
+	{
+		if (Actor.IsValid())
+		{
+			Actors.Add(Actor.Get());
+		}
+	}
+	return Actors;
+}
+
+namespace ActorDuplication
+{
+	// Tag that rides along through the DUPLICATE command's T3D round trip; its number is the
+	// original's index + 1, so copies find their original without relying on selection order
+	static const FName DuplicateSourceTag(TEXT("LevelEditorShortcutsDuplicateSource"));
+
+	static int32 FindSourceIndex(const AActor* Copy, int32& OutTagIndex)
+	{
+		for (int32 TagIndex = 0; TagIndex < Copy->Tags.Num(); TagIndex++)
+		{
+			const FName& Tag = Copy->Tags[TagIndex];
+			if (Tag.GetComparisonIndex() == DuplicateSourceTag.GetComparisonIndex() && Tag.GetNumber() > 0)
+			{
+				OutTagIndex = TagIndex;
+				return Tag.GetNumber() - 1;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	bool CanDuplicateDirectly(TConstArrayView<AActor*> Actors)
+	{
+		// Exact classes only: subclasses (Blueprints included) may rely on PostEditImport or own
+		// components the template spawn doesn't copy
+		static const UClass* const DirectClasses[] = {
+			AStaticMeshActor::StaticClass(),
+			APointLight::StaticClass(),
+			ASpotLight::StaticClass(),
+			ARectLight::StaticClass(),
+			ADecalActor::StaticClass()
+		};
+
+		for (AActor* Actor : Actors)
+		{
+			if (!MakeArrayView(DirectClasses).Contains(Actor->GetClass()) || Actor->GetInstanceComponents().Num() > 0 || AGroupActor::GetRootForActor(Actor))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void DuplicateDirectly(TConstArrayView<AActor*> Actors, FCopyMap& OutCopies)
+	{
+		OutCopies.Reset();
+		if (Actors.Num() == 0)
+		{
+			return;
+		}
+
+		UWorld* World = Actors[0]->GetWorld();
+
+		// One label scan for the whole batch instead of one per copy
+		FCachedActorLabels ActorLabels(World);
+		OutCopies.Reserve(Actors.Num());
+
+		for (AActor* Source : Actors)
+		{
+			// Child actors are recreated by their owning component's copy
+			if (!IsValid(Source) || Source->IsChildActor())
+			{
+				continue;
+			}
+
+			ULevel* Level = Source->GetLevel();
+			Level->Modify();
+
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.Template = Source;
+			SpawnParams.OverrideLevel = Level;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			SpawnParams.ObjectFlags |= RF_Transactional;
+			SpawnParams.bNoFail = true;
+
+			const FTransform Transform = Source->GetActorTransform();
+			AActor* Copy = World->SpawnActor(Source->GetClass(), &Transform, SpawnParams);
+			if (!Copy)
+			{
+				continue;
+			}
+
+			FActorLabelUtilities::SetActorLabelUnique(Copy, Source->GetActorLabel(), &ActorLabels);
+			ActorLabels.Add(Copy->GetActorLabel());
+
+			OutCopies.Add(Source, Copy);
+		}
+
+		// Re-create attachments: to the parent's copy when the parent was duplicated too, otherwise
+		// next to the original under the same parent, at the original's relative transform
+		for (const TPair<AActor*, AActor*>& Pair : OutCopies)
+		{
+			USceneComponent* SourceRoot = Pair.Key->GetRootComponent();
+			USceneComponent* CopyRoot = Pair.Value->GetRootComponent();
+			USceneComponent* SourceParent = SourceRoot ? SourceRoot->GetAttachParent() : nullptr;
+			if (!CopyRoot || !SourceParent)
+			{
+				continue;
+			}
+
+			USceneComponent* NewParent = SourceParent;
+			if (AActor* const* ParentCopy = OutCopies.Find(SourceParent->GetOwner()))
+			{
+				NewParent = (*ParentCopy)->GetRootComponent();
+			}
+			CopyRoot->AttachToComponent(NewParent, FAttachmentTransformRules::KeepRelativeTransform, SourceRoot->GetAttachSocketName());
+			CopyRoot->SetRelativeTransform(SourceRoot->GetRelativeTransform());
+		}
+
+		for (const TPair<AActor*, AActor*>& Pair : OutCopies)
+		{
+			Pair.Value->PostEditMove(true);
+		}
+	}
+
+	void DuplicateWithEditorCommand(TConstArrayView<AActor*> Actors, FCopyMap& OutCopies)
+	{
+		OutCopies.Reset();
+
+		// Store original transforms and mark each original (outside any transaction, removed below)
+		TArray<FTransform> OriginalTransforms;
+		OriginalTransforms.Reserve(Actors.Num());
+		for (int32 i = 0; i < Actors.Num(); i++)
+		{
+			OriginalTransforms.Add(Actors[i]->GetActorTransform());
+			Actors[i]->Tags.Add(FName(DuplicateSourceTag, i + 1));
+		}
+
+		// One undo step for the command and the move back: DUPLICATE's own transaction nests in here
+		FScopedTransaction Transaction(FText::FromString(TEXT("Duplicate In Place")));
+
+		// Execute the standard duplicate command, collecting whatever it spawns
+		TArray<AActor*> AddedActors;
+		{
+			FScopedAddedActorCapture Capture;
+			GEditor->Exec(GEditor->GetEditorWorldContext().World(), TEXT("DUPLICATE"));
+			AddedActors = Capture.GetActors();
+		}
+
+		for (int32 i = 0; i < Actors.Num(); i++)
+		{
+			int32 TagIndex = INDEX_NONE;
+			if (FindSourceIndex(Actors[i], TagIndex) == i)
+			{
+				Actors[i]->Tags.RemoveAt(TagIndex);
+			}
+		}
+
+		// Strip the marks from the copies before they are moved back, so the recorded move doesn't
+		// keep them; copies without a mark (group or child actors the command created on its own)
+		// follow their parents
+		TArray<TPair<AActor*, int32>> MarkedCopies;
+		for (AActor* Copy : AddedActors)
+		{
+			int32 TagIndex = INDEX_NONE;
+			const int32 SourceIndex = FindSourceIndex(Copy, TagIndex);
+			if (TagIndex != INDEX_NONE)
+			{
+				Copy->Tags.RemoveAt(TagIndex);
+			}
+			if (Actors.IsValidIndex(SourceIndex))
+			{
+				MarkedCopies.Emplace(Copy, SourceIndex);
+			}
+		}
+
+		if (MarkedCopies.Num() == 0)
+		{
+			if (AddedActors.Num() == 0)
+			{
+				Transaction.Cancel(); // Nothing was copied - leave no empty undo step
+			}
+			return;
+		}
+
+		// Move every marked copy back onto its own original
+		for (const TPair<AActor*, int32>& Pair : MarkedCopies)
+		{
+			AActor* Copy = Pair.Key;
+			Copy->Modify();
+			Copy->SetActorTransform(OriginalTransforms[Pair.Value]);
+			Copy->PostEditMove(true);
+			OutCopies.Add(Actors[Pair.Value], Copy);
+		}
+	}
+
+	// Direct clone inside one transaction, with the copies replacing the originals in the selection
+	static void DuplicateDirectlyAndSelect(TConstArrayView<AActor*> Actors)
+	{
+		FScopedTransaction Transaction(FText::FromString(TEXT("Duplicate In Place")));
+
+		FCopyMap Copies;
+		DuplicateDirectly(Actors, Copies);
+
+		USelection* Selection = GEditor->GetSelectedActors();
+		Selection->BeginBatchSelectOperation();
+		GEditor->SelectNone(false, true, false);
+		for (const TPair<AActor*, AActor*>& Pair : Copies)
+		{
+			GEditor->SelectActor(Pair.Value, true, false);
+		}
+		Selection->EndBatchSelectOperation(false);
+	}
+
+	bool DuplicateInPlace(TConstArrayView<AActor*> Actors)
+	{
+		if (!GEditor || Actors.Num() == 0)
+		{
+			return false;
+		}
+
+		if (CanDuplicateDirectly(Actors))
+		{
+			DuplicateDirectlyAndSelect(Actors);
+		}
+		else
+		{
+			FCopyMap Copies;
+			DuplicateWithEditorCommand(Actors, Copies);
+		}
+
+		GEditor->NoteSelectionChange();
+		GEditor->RedrawLevelEditingViewports();
+		return true;
+	}
+}
+
+// Transactions Ctrl+Z can still undo
+static int32 GetNumUndoable()
+{
+	return GEditor->Trans ? GEditor->Trans->GetQueueLength() - GEditor->Trans->GetUndoCount() : 0;
+}
+
+// Undo exactly the transactions added since NumBefore, however many the path created
+static void UndoSince(int32 NumBefore)
+{
+	for (int32 NumToUndo = GetNumUndoable() - NumBefore; NumToUndo > 0; NumToUndo--)
+	{
+		GEditor->UndoTransaction();
+	}
+}
+
+// LevelEditorShortcuts.BenchmarkDuplicateInPlace - duplicates the selection once through the
+// DUPLICATE command path and once through the direct clone, undoing each right after
+static void RunDuplicateBenchmark()
+{
+	USelection* Selection = GEditor ? GEditor->GetSelectedActors() : nullptr;
+	if (!Selection)
+	{
+		return;
+	}
+
+	TArray<AActor*> Actors;
+	Selection->GetSelectedObjects<AActor>(Actors);
+	if (Actors.Num() == 0)
+	{
+		UE_LOG(LogLevelEditorShortcuts, Warning, TEXT("BenchmarkDuplicateInPlace: select the actors to duplicate first"));
+		return;
+	}
+	if (!ActorDuplication::CanDuplicateDirectly(Actors))
+	{
+		UE_LOG(LogLevelEditorShortcuts, Warning, TEXT("BenchmarkDuplicateInPlace: select only static mesh, light or decal actors; anything else always uses the DUPLICATE command"));
+		return;
+	}
+
+	// DUPLICATE + move back is one transaction, or none if nothing was copied
+	ActorDuplication::FCopyMap Copies;
+	int32 NumUndoable = GetNumUndoable();
+	double StartTime = FPlatformTime::Seconds();
+	ActorDuplication::DuplicateWithEditorCommand(Actors, Copies);
+	const double CommandMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	UndoSince(NumUndoable);
+
+	NumUndoable = GetNumUndoable();
+	StartTime = FPlatformTime::Seconds();
+	ActorDuplication::DuplicateInPlace(Actors);
+	const double DirectMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	UndoSince(NumUndoable);
+
+	UE_LOG(LogLevelEditorShortcuts, Display, TEXT("Duplicate in place: %d actors, DUPLICATE command %.1f ms -> direct clone %.1f ms"),
+		Actors.Num(), CommandMs, DirectMs);
+}
+
+static FAutoConsoleCommand BenchmarkDuplicateInPlaceCommand(
+	TEXT("LevelEditorShortcuts.BenchmarkDuplicateInPlace"),
+	TEXT("Times duplicate-in-place of the selected actors through the editor's DUPLICATE command and through the direct clone (each is undone right away)."),
+	FConsoleCommandDelegate::CreateStatic(&RunDuplicateBenchmark));
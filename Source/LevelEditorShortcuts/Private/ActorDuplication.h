@@ -0,0 +1,52 @@
+// ActorDuplication.h
+// Duplicate-in-place for the shortcut processors: clones plain mesh, light and decal actors at their
+// exact transforms by spawning each one from the original as template, instead of the editor's
+// DUPLICATE command (T3D export/import, default offset, then a second transaction to move the
+// copies back). Everything else still goes through DUPLICATE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+// Collects every actor added to any level while in scope (GEngine's OnLevelActorAdded), so an
+// editor command's results can be picked up without snapshotting the world before and after
+class FScopedAddedActorCapture
+{
+public:
+	FScopedAddedActorCapture();
+	~FScopedAddedActorCapture();
+
+	// Added actors that still exist, in the order they were added
+	TArray<AActor*> GetActors() const;
+
+private:
+	TArray<TWeakObjectPtr<AActor>> AddedActors;
+	FDelegateHandle ActorAddedHandle;
+};
+
+namespace ActorDuplication
+{
+	// Original -> copy
+	using FCopyMap = TMap<AActor*, AActor*>;
+
+	// True only if every actor is exactly one of the plain native classes a template spawn copies
+	// completely (static mesh, point/spot/rect light, decal) with no instance-added components.
+	// A template spawn skips PostDuplicate/PostEditImport and doesn't deep-copy instance components,
+	// so Blueprints, brushes, groups and anything else need the editor's DUPLICATE command.
+	bool CanDuplicateDirectly(TConstArrayView<AActor*> Actors);
+
+	// Spawn a copy of every actor at its current transform, in its level and folder, with a unique
+	// label; copies of attached actors are attached to their parent's copy when it was duplicated too.
+	// The caller owns the transaction. Actors that couldn't be copied have no entry.
+	void DuplicateDirectly(TConstArrayView<AActor*> Actors, FCopyMap& OutCopies);
+
+	// The editor's DUPLICATE command (Actors must be the selection), with each copy moved back onto
+	// its own original, all in one transaction. Originals are matched to copies by identity, not by
+	// selection order, so groups, child actors and skipped actors can't misalign them.
+	void DuplicateWithEditorCommand(TConstArrayView<AActor*> Actors, FCopyMap& OutCopies);
+
+	// Duplicate the actors in place through whichever path applies and select the copies
+	bool DuplicateInPlace(TConstArrayView<AActor*> Actors);
+}
@@ -0,0 +1,108 @@
+// FolderAssignment.cpp
+// Bulk folder assignment with one consolidated Outliner notification.
+
+#include "FolderAssignment.h"
+#include "Editor.h"
+#include "EditorActorFolders.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "ActorFolder.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UnrealType.h"
+
+static TAutoConsoleVariable<float> CVarBulkFolderMoveFraction(
+	TEXT("LevelEditorShortcuts.BulkFolderMoveFraction"),
+	0.05f,
+	TEXT("Folder moves of at least this fraction of the world's actors skip the per-actor folder events and refresh the Outliner once. 0 = always."),
+	ECVF_Default);
+
+// Below this the per-actor events are always cheaper than a full Outliner refresh
+static constexpr int32 MinBulkActors = 16;
+
+namespace FolderAssignment
+{
+	// The full refresh costs about as much as the world's actor count; per-actor events cost the move
+	static bool ShouldMoveInBulk(const UWorld* World, int32 NumActors)
+	{
+		if (!World || NumActors < MinBulkActors)
+		{
+			return false;
+		}
+		return NumActors >= World->GetActorCount() * FMath::Max(0.0f, CVarBulkFolderMoveFraction.GetValueOnGameThread());
+	}
+
+	void MoveActorsToFolder(TConstArrayView<AActor*> Actors, const FName& FolderPath)
+	{
+		if (Actors.Num() == 0)
+		{
+			return;
+		}
+
+		// Folder properties are only reachable through SetFolderPath (which broadcasts); write them
+		// through reflection for the bulk path. Levels using actor folder objects (the World
+		// Partition default) store the folder's GUID, everything else the path.
+		static FNameProperty* FolderPathProperty = FindFProperty<FNameProperty>(AActor::StaticClass(), TEXT("FolderPath"));
+		static FStructProperty* FolderGuidProperty = FindFProperty<FStructProperty>(AActor::StaticClass(), TEXT("FolderGuid"));
+		const bool bBulk = FolderPathProperty && ShouldMoveInBulk(Actors[0]->GetWorld(), Actors.Num());
+
+		// Silent moves don't create the folder the way SetFolderPath does
+		TSet<FFolder> KnownFolders;
+
+		int32 NumSilent = 0;
+		for (AActor* Actor : Actors)
+		{
+			if (!IsValid(Actor) || Actor->GetFolderPath() == FolderPath)
+			{
+				continue;
+			}
+
+			ULevel* Level = Actor->GetLevel();
+			UWorld* World = Actor->GetWorld();
+			if (!bBulk || !Level || !World)
+			{
+				Actor->Modify();
+				Actor->SetFolderPath(FolderPath);
+				continue;
+			}
+
+			if (!FolderPath.IsNone())
+			{
+				const FFolder Folder(Actor->GetFolderRootObject(), FolderPath);
+				if (!KnownFolders.Contains(Folder))
+				{
+					if (!FActorFolders::Get().ContainsFolder(*World, Folder))
+					{
+						FActorFolders::Get().CreateFolder(*World, Folder);
+					}
+					KnownFolders.Add(Folder);
+				}
+			}
+
+			Actor->Modify();
+			if (Level->IsUsingActorFolders())
+			{
+				const UActorFolder* ActorFolder = FolderPath.IsNone() ? nullptr : Level->GetActorFolder(FolderPath);
+				if (!FolderGuidProperty || (!FolderPath.IsNone() && !ActorFolder))
+				{
+					Actor->SetFolderPath(FolderPath);
+					continue;
+				}
+				*FolderGuidProperty->ContainerPtrToValuePtr<FGuid>(Actor) = ActorFolder ? ActorFolder->GetGuid() : FGuid();
+				FolderPathProperty->SetPropertyValue_InContainer(Actor, NAME_None);
+			}
+			else
+			{
+				FolderPathProperty->SetPropertyValue_InContainer(Actor, FolderPath);
+			}
+			NumSilent++;
+		}
+
+		// One rebuild for everything moved silently
+		if (NumSilent > 0 && GEngine)
+		{
+			GEngine->BroadcastLevelActorListChanged();
+		}
+	}
+}
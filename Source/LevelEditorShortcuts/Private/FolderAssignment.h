@@ -0,0 +1,18 @@
+// FolderAssignment.h
+// Bulk World Outliner folder moves for the shortcut processors. AActor::SetFolderPath broadcasts a
+// folder-changed event per actor, which the Outliner handles one by one; moves of a large share of
+// the world's actors (LevelEditorShortcuts.BulkFolderMoveFraction) apply every change first and send
+// a single actor-list-changed notification instead, in both path- and actor-folder-based levels.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+namespace FolderAssignment
+{
+	// Put every actor in FolderPath (NAME_None = world root), creating the folder if needed.
+	// The caller owns the transaction.
+	void MoveActorsToFolder(TConstArrayView<AActor*> Actors, const FName& FolderPath);
+}
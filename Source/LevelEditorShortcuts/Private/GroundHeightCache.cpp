@@ -0,0 +1,598 @@
+// GroundHeightCache.cpp
+// Tiled ground height/normal cache used by ground snap, plus its invalidation hooks.
+
+#include "GroundHeightCache.h"
+#include "GroundSnap.h"
+#include "LevelEditorShortcutsLog.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/Actor.h"
+#include "Components/PrimitiveComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "LandscapeProxy.h"
+#include "LandscapeComponent.h"
+#include "UObject/UObjectGlobals.h"
+#include "Subsystems/ImportSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Stats/Stats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Height Cache Hits"), STAT_LevelEditorShortcuts_HeightCacheHits, STATGROUP_LevelEditorShortcuts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Height Cache Traces"), STAT_LevelEditorShortcuts_HeightCacheTraces, STATGROUP_LevelEditorShortcuts);
+
+static TAutoConsoleVariable<int32> CVarHeightCacheMaxMB(
+	TEXT("LevelEditorShortcuts.HeightCacheMaxMB"),
+	64,
+	TEXT("Memory budget of the ground height cache in MB; least recently used tiles are evicted past it. 0 = disable the cache."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarHeightCacheCellSize(
+	TEXT("LevelEditorShortcuts.HeightCacheCellSize"),
+	50.0f,
+	TEXT("Spacing of the ground height cache samples in world units. Changing it flushes the cache."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarHeightCacheTracesPerFrame(
+	TEXT("LevelEditorShortcuts.HeightCacheTracesPerFrame"),
+	1024,
+	TEXT("Async traces the ground height cache submits per frame to build queued tiles."),
+	ECVF_Default);
+
+// Samples per tile side; a sample index must fit the low 8 bits of the trace user data
+static constexpr int32 TileSize = 16;
+static constexpr int32 SamplesPerTile = TileSize * TileSize;
+static_assert(SamplesPerTile <= 256, "Sample index must fit in 8 bits");
+
+// Corner normals must agree this closely for a cached sample to be interpolated; creases and
+// steps inside one mesh are left to a trace
+static constexpr float CreaseCosTolerance = 0.95f;
+
+// Missed tiles remembered for a second query before the list starts over
+static constexpr int32 MaxMissedTiles = 65536;
+
+static TUniquePtr<FGroundHeightCache> Instance;
+
+static int64 FloorDiv(int64 A, int64 B)
+{
+	return A >= 0 ? A / B : -((-A + B - 1) / B);
+}
+
+FGroundHeightCache::FGroundHeightCache()
+{
+	TraceDelegate.BindRaw(this, &FGroundHeightCache::OnTraceCompleted);
+
+	if (GEngine)
+	{
+		ActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FGroundHeightCache::Invalidate);
+		ActorsMovedHandle = GEngine->OnActorsMoved().AddLambda([this](TArray<AActor*>& Actors)
+		{
+			for (AActor* Actor : Actors)
+			{
+				Invalidate(Actor);
+			}
+		});
+		ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FGroundHeightCache::Invalidate);
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FGroundHeightCache::Invalidate);
+	}
+
+	// Undo/redo and level loads move geometry without per-actor notifications
+	UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FGroundHeightCache::Reset);
+	MapChangeHandle = FEditorDelegates::MapChange.AddRaw(this, &FGroundHeightCache::OnMapChange);
+
+	// Collision profile, mesh and shape edits, reimports and landscape sculpting change geometry in place
+	PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([this](UObject* Object, FPropertyChangedEvent&)
+	{
+		OnObjectChanged(Object);
+	});
+	if (UImportSubsystem* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr)
+	{
+		ReimportHandle = ImportSubsystem->OnAssetReimport.AddRaw(this, &FGroundHeightCache::OnObjectChanged);
+	}
+	LandscapeChangedHandle = ALandscapeProxy::OnComponentDataChanged().AddRaw(this, &FGroundHeightCache::OnLandscapeChanged);
+}
+
+FGroundHeightCache::~FGroundHeightCache()
+{
+	if (GEngine)
+	{
+		GEngine->OnActorMoved().Remove(ActorMovedHandle);
+		GEngine->OnActorsMoved().Remove(ActorsMovedHandle);
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+	}
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+	FEditorDelegates::MapChange.Remove(MapChangeHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+	if (UImportSubsystem* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr)
+	{
+		ImportSubsystem->OnAssetReimport.Remove(ReimportHandle);
+	}
+	ALandscapeProxy::OnComponentDataChanged().Remove(LandscapeChangedHandle);
+}
+
+FGroundHeightCache* FGroundHeightCache::Get()
+{
+	return CVarHeightCacheMaxMB.GetValueOnGameThread() > 0 ? Instance.Get() : nullptr;
+}
+
+TStatId FGroundHeightCache::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FGroundHeightCache, STATGROUP_Tickables);
+}
+
+void FGroundHeightCache::Reset()
+{
+	Tiles.Empty();
+	TotalBytes = 0;
+	BuildQueue.Empty();
+	QueuedStartZ.Empty();
+	Builds.Empty();
+	MissedTiles.Empty();
+	IgnoredActors.Empty();
+	CachedWorld.Reset();
+}
+
+void FGroundHeightCache::OnMapChange(uint32 MapChangeFlags)
+{
+	Reset();
+}
+
+void FGroundHeightCache::Prepare(UWorld* World, TConstArrayView<AActor*> Actors)
+{
+	if (!World || Actors.Num() == 0)
+	{
+		return;
+	}
+
+	// Samples ignore what the snap traces ignore or skip
+	TMap<FObjectKey, TWeakObjectPtr<AActor>> Ignored;
+	TArray<AActor*> AttachedActors;
+	for (AActor* Actor : Actors)
+	{
+		Ignored.Add(FObjectKey(Actor), Actor);
+		AttachedActors.Reset();
+		Actor->GetAttachedActors(AttachedActors, true, true);
+		for (AActor* Attached : AttachedActors)
+		{
+			Ignored.Add(FObjectKey(Attached), Attached);
+		}
+	}
+
+	PrepareEpoch++;
+
+	const double NewCellSize = FMath::Max(1.0, (double)CVarHeightCacheCellSize.GetValueOnGameThread());
+	if (CachedWorld.Get() != World || CellSize != NewCellSize)
+	{
+		Reset();
+		CachedWorld = World;
+		CellSize = NewCellSize;
+	}
+	else
+	{
+		// Actors that became ground or stopped being ground only change the tiles around them
+		bool bChanged = false;
+		for (const TPair<FObjectKey, TWeakObjectPtr<AActor>>& Pair : IgnoredActors)
+		{
+			if (!Ignored.Contains(Pair.Key))
+			{
+				bChanged = true;
+				if (const AActor* Actor = Pair.Value.Get())
+				{
+					DropTilesTouching(Actor);
+				}
+			}
+		}
+		for (const TPair<FObjectKey, TWeakObjectPtr<AActor>>& Pair : Ignored)
+		{
+			if (!IgnoredActors.Contains(Pair.Key))
+			{
+				bChanged = true;
+				if (const AActor* Actor = Pair.Value.Get())
+				{
+					DropTilesTouching(Actor);
+				}
+			}
+		}
+
+		// Traces in flight were set up to ignore the old set
+		if (bChanged)
+		{
+			Builds.Empty();
+			BuildQueue.Empty();
+			QueuedStartZ.Empty();
+		}
+	}
+
+	IgnoredActors = MoveTemp(Ignored);
+
+	TArray<AActor*> IgnoredArray;
+	IgnoredArray.Reserve(IgnoredActors.Num());
+	for (const TPair<FObjectKey, TWeakObjectPtr<AActor>>& Pair : IgnoredActors)
+	{
+		if (AActor* Actor = Pair.Value.Get())
+		{
+			IgnoredArray.Add(Actor);
+		}
+	}
+	QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(LevelEditorShortcutsHeightCache));
+	QueryParams.AddIgnoredActors(IgnoredArray);
+}
+
+void FGroundHeightCache::RequestFootprints(TConstArrayView<FBox> Footprints, int32 MaxNewTiles)
+{
+	if (!CachedWorld.IsValid() || Footprints.Num() == 0)
+	{
+		return;
+	}
+
+	UseCounter++;
+
+	// Tiles under every footprint (one cell of margin for the interpolation corners)
+	const double TileExtent = CellSize * TileSize;
+	int32 NumQueued = 0;
+	for (const FBox& Footprint : Footprints)
+	{
+		// Tiles start higher than strictly needed so slowly rising queries (drags uphill) keep hitting them
+		const double StartZ = Footprint.Max.Z + 2.0 * GroundSnap::TraceStartHeight;
+
+		const int32 MinX = FMath::FloorToInt32((Footprint.Min.X - CellSize) / TileExtent);
+		const int32 MinY = FMath::FloorToInt32((Footprint.Min.Y - CellSize) / TileExtent);
+		const int32 MaxX = FMath::FloorToInt32((Footprint.Max.X + CellSize) / TileExtent);
+		const int32 MaxY = FMath::FloorToInt32((Footprint.Max.Y + CellSize) / TileExtent);
+		for (int32 Y = MinY; Y <= MaxY; Y++)
+		{
+			for (int32 X = MinX; X <= MaxX; X++)
+			{
+				const FIntPoint Coord(X, Y);
+				FTile* Tile = Tiles.Find(Coord);
+				if (Tile && Tile->StartZ >= StartZ - GroundSnap::TraceStartHeight)
+				{
+					Tile->LastUsed = UseCounter;
+				}
+				else if (NumQueued < MaxNewTiles && QueueTile(Coord, StartZ))
+				{
+					NumQueued++;
+				}
+			}
+		}
+	}
+}
+
+bool FGroundHeightCache::QueueTile(const FIntPoint& Coord, double StartZ)
+{
+	if (double* Queued = QueuedStartZ.Find(Coord))
+	{
+		*Queued = FMath::Max(*Queued, StartZ);
+		return false;
+	}
+	for (const TPair<uint32, FTileBuild>& Pair : Builds)
+	{
+		if (Pair.Value.Coord == Coord && Pair.Value.Tile.StartZ >= StartZ)
+		{
+			return false;
+		}
+	}
+
+	QueuedStartZ.Add(Coord, StartZ);
+	BuildQueue.Add(Coord);
+	return true;
+}
+
+void FGroundHeightCache::Tick(float DeltaTime)
+{
+	UWorld* World = CachedWorld.Get();
+	if (!World || (BuildQueue.Num() == 0 && !Builds.Contains(SubmittingBuildId)))
+	{
+		return;
+	}
+
+	int32 Budget = FMath::Max(1, CVarHeightCacheTracesPerFrame.GetValueOnGameThread());
+	while (Budget > 0)
+	{
+		FTileBuild* Build = Builds.Find(SubmittingBuildId);
+		if (!Build || Build->NumSubmitted == SamplesPerTile)
+		{
+			if (BuildQueue.Num() == 0)
+			{
+				break;
+			}
+			const FIntPoint Coord = BuildQueue[0];
+			BuildQueue.RemoveAt(0);
+			StartBuild(Coord, QueuedStartZ.FindAndRemoveChecked(Coord));
+			continue;
+		}
+
+		const int32 NumToSubmit = FMath::Min(Budget, SamplesPerTile - Build->NumSubmitted);
+		for (int32 i = 0; i < NumToSubmit; i++)
+		{
+			const int32 SampleIndex = Build->NumSubmitted++;
+			const FVector Start((int64(Build->Coord.X) * TileSize + SampleIndex % TileSize) * CellSize,
+				(int64(Build->Coord.Y) * TileSize + SampleIndex / TileSize) * CellSize, Build->Tile.StartZ);
+			World->AsyncLineTraceByObjectType(EAsyncTraceType::Multi, Start, Start - FVector(0, 0, GroundSnap::TraceLength),
+				GroundSnap::GetGroundObjectParams(), QueryParams, &TraceDelegate, (SubmittingBuildId << 8) | uint32(SampleIndex));
+		}
+		INC_DWORD_STAT_BY(STAT_LevelEditorShortcuts_HeightCacheTraces, NumToSubmit);
+		Budget -= NumToSubmit;
+	}
+}
+
+void FGroundHeightCache::StartBuild(const FIntPoint& Coord, double StartZ)
+{
+	// Ids wrap within the 24 bits the trace user data leaves them
+	NextBuildId = (NextBuildId + 1) & 0xFFFFFF;
+	SubmittingBuildId = NextBuildId;
+
+	FTileBuild& Build = Builds.Add(SubmittingBuildId);
+	Build.Coord = Coord;
+	Build.Tile.Samples.SetNum(SamplesPerTile);
+	Build.Tile.StartZ = StartZ;
+}
+
+void FGroundHeightCache::OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	// Builds dropped while their traces were in flight just lose the results
+	FTileBuild* Build = Builds.Find(Datum.UserData >> 8);
+	if (!Build)
+	{
+		return;
+	}
+
+	if (const FHitResult* Hit = GroundSnap::FindGroundHit(Datum.OutHits))
+	{
+		FSample& Sample = Build->Tile.Samples[Datum.UserData & 0xFF];
+		Sample.Height = Hit->ImpactPoint.Z;
+		Sample.Normal = FVector3f(Hit->ImpactNormal);
+		Sample.Surface = FObjectKey(Hit->GetComponent());
+		Build->Tile.SurfaceActors.Add(FObjectKey(Hit->GetActor()));
+	}
+
+	if (++Build->NumReturned == SamplesPerTile)
+	{
+		AddTile(*Build);
+		Builds.Remove(Datum.UserData >> 8);
+	}
+}
+
+void FGroundHeightCache::AddTile(FTileBuild& Build)
+{
+	FTile& Tile = Build.Tile;
+	Tile.LastUsed = ++UseCounter;
+	Tile.Bytes = sizeof(FIntPoint) + sizeof(FTile) + Tile.Samples.GetAllocatedSize() + Tile.SurfaceActors.GetAllocatedSize();
+
+	if (const FTile* Existing = Tiles.Find(Build.Coord))
+	{
+		TotalBytes -= Existing->Bytes;
+	}
+	TotalBytes += Tile.Bytes;
+	Tiles.Add(Build.Coord, MoveTemp(Tile));
+	MissedTiles.Remove(Build.Coord);
+
+	EvictForBudget(Build.Coord);
+}
+
+void FGroundHeightCache::EvictForBudget(const FIntPoint& Keep)
+{
+	const int64 MaxBytes = int64(CVarHeightCacheMaxMB.GetValueOnGameThread()) * 1024 * 1024;
+	if (TotalBytes <= MaxBytes)
+	{
+		return;
+	}
+
+	TArray<TPair<uint64, FIntPoint>> Candidates;
+	for (const TPair<FIntPoint, FTile>& Pair : Tiles)
+	{
+		if (Pair.Key != Keep)
+		{
+			Candidates.Emplace(Pair.Value.LastUsed, Pair.Key);
+		}
+	}
+	Candidates.Sort([](const TPair<uint64, FIntPoint>& A, const TPair<uint64, FIntPoint>& B) { return A.Key < B.Key; });
+
+	for (int32 i = 0; i < Candidates.Num() && TotalBytes > MaxBytes; i++)
+	{
+		FTile Removed;
+		Tiles.RemoveAndCopyValue(Candidates[i].Value, Removed);
+		TotalBytes -= Removed.Bytes;
+	}
+}
+
+const FGroundHeightCache::FSample* FGroundHeightCache::FindSample(int64 X, int64 Y, double TraceStartZ)
+{
+	const FIntPoint Coord((int32)FloorDiv(X, TileSize), (int32)FloorDiv(Y, TileSize));
+	FTile* Tile = Tiles.Find(Coord);
+	if (!Tile || Tile->StartZ < TraceStartZ)
+	{
+		// Built on the second miss, so one-off queries never pay for a tile
+		uint32& MissEpoch = MissedTiles.FindOrAdd(Coord, PrepareEpoch);
+		if (MissEpoch != PrepareEpoch)
+		{
+			QueueTile(Coord, TraceStartZ + GroundSnap::TraceStartHeight);
+			MissEpoch = PrepareEpoch;
+		}
+		if (MissedTiles.Num() > MaxMissedTiles)
+		{
+			MissedTiles.Reset();
+		}
+		return nullptr;
+	}
+
+	Tile->LastUsed = UseCounter;
+	const int64 LocalX = X - FloorDiv(X, TileSize) * TileSize;
+	const int64 LocalY = Y - FloorDiv(Y, TileSize) * TileSize;
+	return &Tile->Samples[LocalY * TileSize + LocalX];
+}
+
+bool FGroundHeightCache::Sample(const FVector& TraceStart, FHitResult& OutHit)
+{
+	if (!CachedWorld.IsValid())
+	{
+		return false;
+	}
+
+	const double GridX = TraceStart.X / CellSize;
+	const double GridY = TraceStart.Y / CellSize;
+	const int64 X0 = (int64)FMath::FloorToDouble(GridX);
+	const int64 Y0 = (int64)FMath::FloorToDouble(GridY);
+
+	const FSample* Corners[4] = {
+		FindSample(X0, Y0, TraceStart.Z),
+		FindSample(X0 + 1, Y0, TraceStart.Z),
+		FindSample(X0, Y0 + 1, TraceStart.Z),
+		FindSample(X0 + 1, Y0 + 1, TraceStart.Z)
+	};
+
+	// All four corners must lie on one surface, below the start, without a crease between them
+	for (const FSample* Corner : Corners)
+	{
+		if (!Corner || Corner->Surface == FObjectKey() || Corner->Surface != Corners[0]->Surface
+			|| Corner->Height > TraceStart.Z || FVector3f::DotProduct(Corner->Normal, Corners[0]->Normal) < CreaseCosTolerance)
+		{
+			return false;
+		}
+	}
+
+	const float AlphaX = (float)(GridX - X0);
+	const float AlphaY = (float)(GridY - Y0);
+	const float Height = FMath::BiLerp(Corners[0]->Height, Corners[1]->Height, Corners[2]->Height, Corners[3]->Height, AlphaX, AlphaY);
+	const FVector3f Normal = FMath::BiLerp(Corners[0]->Normal, Corners[1]->Normal, Corners[2]->Normal, Corners[3]->Normal, AlphaX, AlphaY).GetSafeNormal();
+
+	INC_DWORD_STAT(STAT_LevelEditorShortcuts_HeightCacheHits);
+	OutHit = GroundSnap::MakeGroundHit(TraceStart, Height, FVector(Normal));
+	return true;
+}
+
+bool FGroundHeightCache::TileOverlaps(const FIntPoint& Coord, const FBox& Bounds) const
+{
+	const double TileExtent = CellSize * TileSize;
+	const double TileMinX = Coord.X * TileExtent - CellSize;
+	const double TileMinY = Coord.Y * TileExtent - CellSize;
+	return Bounds.Max.X >= TileMinX && Bounds.Min.X <= TileMinX + TileExtent + CellSize
+		&& Bounds.Max.Y >= TileMinY && Bounds.Min.Y <= TileMinY + TileExtent + CellSize;
+}
+
+void FGroundHeightCache::DropTilesOverlapping(const FBox& Bounds)
+{
+	if (!Bounds.IsValid)
+	{
+		return;
+	}
+
+	for (auto It = Tiles.CreateIterator(); It; ++It)
+	{
+		if (TileOverlaps(It->Key, Bounds))
+		{
+			TotalBytes -= It->Value.Bytes;
+			It.RemoveCurrent();
+		}
+	}
+	for (auto It = Builds.CreateIterator(); It; ++It)
+	{
+		if (TileOverlaps(It->Value.Coord, Bounds))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FGroundHeightCache::DropTilesTouching(const AActor* Actor)
+{
+	// Tiles resting on it, wherever it went
+	const FObjectKey ActorKey(Actor);
+	for (auto It = Tiles.CreateIterator(); It; ++It)
+	{
+		if (It->Value.SurfaceActors.Contains(ActorKey))
+		{
+			TotalBytes -= It->Value.Bytes;
+			It.RemoveCurrent();
+		}
+	}
+	for (auto It = Builds.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Tile.SurfaceActors.Contains(ActorKey))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Tiles it covers now
+	FBox Bounds(ForceInit);
+	TArray<UPrimitiveComponent*> PrimComps;
+	Actor->GetComponents<UPrimitiveComponent>(PrimComps);
+	for (const UPrimitiveComponent* Comp : PrimComps)
+	{
+		if (GroundSnap::BlocksGroundTrace(Comp))
+		{
+			Bounds += Comp->Bounds.GetBox();
+		}
+	}
+	DropTilesOverlapping(Bounds);
+}
+
+void FGroundHeightCache::Invalidate(AActor* Actor)
+{
+	if (!Actor || (Tiles.Num() == 0 && Builds.Num() == 0) || IgnoredActors.Contains(FObjectKey(Actor)) || Actor->GetWorld() != CachedWorld.Get())
+	{
+		return;
+	}
+
+	DropTilesTouching(Actor);
+}
+
+void FGroundHeightCache::OnObjectChanged(UObject* Object)
+{
+	if (!Object)
+	{
+		return;
+	}
+
+	// Collision profile, shape or mesh swaps on a placed actor only affect the tiles around it
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		Invalidate(Actor);
+	}
+	else if (const UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		Invalidate(Component->GetOwner());
+	}
+
+	// An asset's collision can be under any number of tiles
+	else if (Object->IsA<UStaticMesh>() || Object->IsA<UBodySetup>() || Object->IsA<UPhysicsAsset>())
+	{
+		Reset();
+	}
+}
+
+void FGroundHeightCache::OnLandscapeChanged(ALandscapeProxy* Proxy, const FLandscapeProxyComponentDataChangedParams& Params)
+{
+	if (!Proxy || Proxy->GetWorld() != CachedWorld.Get())
+	{
+		return;
+	}
+
+	// Only the sculpted or painted components, not every tile resting on the landscape
+	FBox Bounds(ForceInit);
+	Params.ForEachComponent([&Bounds](const ULandscapeComponent* Component)
+	{
+		Bounds += Component->Bounds.GetBox();
+	});
+	DropTilesOverlapping(Bounds);
+}
+
+static FAutoConsoleCommand FlushHeightCacheCommand(
+	TEXT("LevelEditorShortcuts.FlushHeightCache"),
+	TEXT("Drops every cached ground height sample. Edits are picked up automatically; this is for changes the editor doesn't report."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (Instance.IsValid())
+		{
+			Instance->Reset();
+		}
+	}));
+
+namespace GroundHeightCache
+{
+	void Register() { Instance = MakeUnique<FGroundHeightCache>(); }
+	void Unregister() { Instance.Reset(); }
+}
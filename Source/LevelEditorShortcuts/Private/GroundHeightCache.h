@@ -0,0 +1,141 @@
+// GroundHeightCache.h
+// Tiled grid of ground samples around the selection, so repeated snaps and surface-following drags
+// read ground height and normal from memory instead of running physics queries. Tiles are only
+// traced for ground that is asked for again (or requested ahead of a drag), through the world's
+// async trace queue under a per-frame budget; they are dropped when geometry in them changes and
+// evicted least-recently-used past the LevelEditorShortcuts.HeightCacheMaxMB budget.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/HitResult.h"
+#include "UObject/ObjectKey.h"
+#include "CollisionQueryParams.h"
+#include "WorldCollision.h"
+#include "TickableEditorObject.h"
+
+class AActor;
+class ALandscapeProxy;
+class UWorld;
+struct FLandscapeProxyComponentDataChangedParams;
+
+class FGroundHeightCache : public FTickableEditorObject
+{
+public:
+	FGroundHeightCache();
+	virtual ~FGroundHeightCache();
+
+	// Null when the cache is disabled or the module isn't running
+	static FGroundHeightCache* Get();
+
+	// Set up for querying ground under the actors. Traces nothing; samples ignore the actors and
+	// everything attached to them, and only tiles around actors that joined or left that set are
+	// dropped. A different world or cell size flushes the cache.
+	void Prepare(UWorld* World, TConstArrayView<AActor*> Actors);
+
+	// Queue the tiles under more footprints for the actors of the last Prepare (e.g. ahead of a
+	// drag), at most MaxNewTiles of them; the rest are picked up by later calls. Queries starting
+	// up to TraceStartHeight above a footprint's top are covered once the tiles are built.
+	void RequestFootprints(TConstArrayView<FBox> Footprints, int32 MaxNewTiles = MAX_int32);
+
+	double GetCellSize() const { return CellSize; }
+
+	// Ground hit straight below TraceStart, interpolated from the four surrounding samples.
+	// Returns false when a physics trace has to decide (uncached, different surfaces, creases, overhangs).
+	// Tiles that miss here again after a later Prepare are queued for building.
+	bool Sample(const FVector& TraceStart, FHitResult& OutHit);
+
+	void Reset();
+
+	// FTickableEditorObject: submits queued tile traces within LevelEditorShortcuts.HeightCacheTracesPerFrame
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Always; }
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FSample
+	{
+		float Height = 0.0f;
+		FVector3f Normal = FVector3f::UpVector;
+
+		// Component the sample rests on; an invalid key means no ground below
+		FObjectKey Surface;
+	};
+
+	struct FTile
+	{
+		TArray<FSample> Samples;
+
+		// Actors the samples rest on, so a move drops the tile even if they leave it
+		TSet<FObjectKey> SurfaceActors;
+
+		// Samples were traced down from here; queries starting higher could hit something above
+		double StartZ = 0.0;
+		uint64 LastUsed = 0;
+
+		// Counted against the memory budget
+		int64 Bytes = 0;
+	};
+
+	// A tile whose traces are in flight; async trace user data is (build id << 8) | sample index
+	struct FTileBuild
+	{
+		FIntPoint Coord;
+		FTile Tile;
+		int32 NumSubmitted = 0;
+		int32 NumReturned = 0;
+	};
+
+	const FSample* FindSample(int64 X, int64 Y, double TraceStartZ);
+	// False if the tile was already queued or is being built high enough
+	bool QueueTile(const FIntPoint& Coord, double StartZ);
+	void StartBuild(const FIntPoint& Coord, double StartZ);
+	void OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+	void AddTile(FTileBuild& Build);
+	void EvictForBudget(const FIntPoint& Keep);
+
+	// Tile (with its one-cell interpolation margin) overlaps Bounds in XY
+	bool TileOverlaps(const FIntPoint& Coord, const FBox& Bounds) const;
+
+	// Drop built and in-flight tiles that rest on the actor or that its blocking geometry covers
+	void DropTilesTouching(const AActor* Actor);
+	void DropTilesOverlapping(const FBox& Bounds);
+
+	// Geometry moved, appeared, went away or changed: drop the tiles it touched
+	void Invalidate(AActor* Actor);
+	void OnObjectChanged(UObject* Object);
+	void OnLandscapeChanged(ALandscapeProxy* Proxy, const FLandscapeProxyComponentDataChangedParams& Params);
+	void OnMapChange(uint32 MapChangeFlags);
+
+	TMap<FIntPoint, FTile> Tiles;
+	int64 TotalBytes = 0;
+
+	// Waiting for trace budget, in request order, with the start height each needs
+	TArray<FIntPoint> BuildQueue;
+	TMap<FIntPoint, double> QueuedStartZ;
+
+	TMap<uint32, FTileBuild> Builds;
+	uint32 NextBuildId = 0;
+	uint32 SubmittingBuildId = MAX_uint32;
+	FTraceDelegate TraceDelegate;
+
+	// Tiles a Sample missed, with the Prepare epoch it happened in
+	TMap<FIntPoint, uint32> MissedTiles;
+	uint32 PrepareEpoch = 0;
+
+	TWeakObjectPtr<UWorld> CachedWorld;
+	TMap<FObjectKey, TWeakObjectPtr<AActor>> IgnoredActors;
+	FCollisionQueryParams QueryParams;
+	double CellSize = 0.0;
+	uint64 UseCounter = 0;
+
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle ActorsMovedHandle;
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle UndoRedoHandle;
+	FDelegateHandle MapChangeHandle;
+	FDelegateHandle PropertyChangedHandle;
+	FDelegateHandle ReimportHandle;
+	FDelegateHandle LandscapeChangedHandle;
+};
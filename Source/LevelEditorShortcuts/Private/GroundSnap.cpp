@@ -0,0 +1,1483 @@
+// GroundSnap.cpp
+// Ground snap helpers and the batched asynchronous snap used for large selections.
+
+#include "GroundSnap.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "Engine/Selection.h"
+#include "GameFramework/Actor.h"
+#include "ScopedTransaction.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/SkeletalMesh.h"
+#include "StaticMeshResources.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+#include "Subsystems/ImportSubsystem.h"
+#include "TransformKernels.h"
+#include "LandscapeGround.h"
+#include "GroundHeightCache.h"
+#include "LevelEditorShortcutsLog.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Stats/Stats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ground Snap Traces"), STAT_LevelEditorShortcuts_GroundSnapTraces, STATGROUP_LevelEditorShortcuts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bottom Offset Cache Hits"), STAT_LevelEditorShortcuts_BottomOffsetCacheHits, STATGROUP_LevelEditorShortcuts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bottom Offset Cache Misses"), STAT_LevelEditorShortcuts_BottomOffsetCacheMisses, STATGROUP_LevelEditorShortcuts);
+
+static TAutoConsoleVariable<int32> CVarAsyncSnapTracesPerFrame(
+	TEXT("LevelEditorShortcuts.AsyncSnapTracesPerFrame"),
+	2048,
+	TEXT("Maximum number of ground snap traces submitted to the async trace queue per frame."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAsyncSnapProgressThreshold(
+	TEXT("LevelEditorShortcuts.AsyncSnapProgressThreshold"),
+	2000,
+	TEXT("Batched ground snaps of at least this many actors show a progress notification with a cancel button."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSnapFootprintSamples(
+	TEXT("LevelEditorShortcuts.SnapFootprintSamples"),
+	3,
+	TEXT("Ground snap casts an N x N grid of rays under each actor's bounds and rests it on the fitted plane. 1 = single ray at the pivot."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSnapSweepShapes(
+	TEXT("LevelEditorShortcuts.SnapSweepShapes"),
+	0,
+	TEXT("1 = snap to ground sweeps the actor's simple collision shapes straight down and rests it at first contact (handles overhangs, no bottom offset or clearance fudge). 0 = footprint line traces."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLandscapeSnapFastPath(
+	TEXT("LevelEditorShortcuts.LandscapeSnapFastPath"),
+	1,
+	TEXT("Ground snap reads height and normal straight from the landscape heightfield for columns that hold no other blocking geometry (footprint trace mode only)."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLandscapeSnapMinActors(
+	TEXT("LevelEditorShortcuts.LandscapeSnapMinActors"),
+	32,
+	TEXT("Smallest selection that sets up the landscape fast path; it scans the level once per snap, which only pays off for larger selections."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarHeightCacheMinActors(
+	TEXT("LevelEditorShortcuts.HeightCacheMinActors"),
+	32,
+	TEXT("Smallest selection whose ground snap fills and reads the ground height cache (footprint trace mode only)."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarBottomOffsetCacheSize(
+	TEXT("LevelEditorShortcuts.BottomOffsetCacheSize"),
+	65536,
+	TEXT("Maximum cached (mesh, orientation) lowest-point entries used by ground snap before the cache is flushed."),
+	ECVF_Default);
+
+namespace GroundSnap
+{
+	bool IsGroundCollision(const UPrimitiveComponent* Component)
+	{
+		if (!Component)
+		{
+			return false;
+		}
+
+		const ECollisionEnabled::Type CollisionType = Component->GetCollisionEnabled();
+		return CollisionType == ECollisionEnabled::QueryAndPhysics || CollisionType == ECollisionEnabled::PhysicsOnly;
+	}
+
+	// Lowest point of one component asset along a direction given in the component's local space.
+	// Results are cached per asset and quantized direction; the direction folds in the component's
+	// rotation and scale relative to the ground normal, so every yaw of an upright prop shares one entry.
+	// Grouped by asset so an edited or reimported asset drops only its own entries.
+	static TMap<FObjectKey, TMap<FIntVector, float>> SupportCache;
+	static int32 NumSupportEntries = 0;
+	static FDelegateHandle PropertyChangedHandle;
+	static FDelegateHandle ReimportHandle;
+
+	// Actors with more collision pieces than this sweep their oriented bounds instead
+	constexpr int32 MaxSweepShapes = 8;
+
+	// Stacked snaps: an actor must sit this much higher to count as resting on another,
+	// and actors spanning more hash cells than this are treated as large supports
+	constexpr double StackTolerance = 1.0;
+	constexpr int64 MaxStackCellsPerActor = 64;
+
+	// Footprint rays cover this fraction of the actor's bounds
+	constexpr double FootprintInset = 0.8;
+
+	// Quantization steps per unit of the normalized direction (~0.01 degrees)
+	constexpr float SupportDirectionSteps = 4096.0f;
+
+	static const FPositionVertexBuffer* GetLOD0Positions(const UPrimitiveComponent* Component)
+	{
+		const FPositionVertexBuffer* Positions = nullptr;
+		if (const UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Component))
+		{
+			const UStaticMesh* Mesh = StaticMeshComp->GetStaticMesh();
+			const FStaticMeshRenderData* RenderData = Mesh ? Mesh->GetRenderData() : nullptr;
+			if (RenderData && RenderData->LODResources.Num() > 0)
+			{
+				Positions = &RenderData->LODResources[0].VertexBuffers.PositionVertexBuffer;
+			}
+		}
+		else if (const USkeletalMeshComponent* SkelMeshComp = Cast<USkeletalMeshComponent>(Component))
+		{
+			const USkeletalMesh* Mesh = SkelMeshComp->GetSkeletalMeshAsset();
+			const FSkeletalMeshRenderData* RenderData = Mesh ? Mesh->GetResourceForRendering() : nullptr;
+			if (RenderData && RenderData->LODRenderData.Num() > 0)
+			{
+				Positions = &RenderData->LODRenderData[0].StaticVertexBuffers.PositionVertexBuffer;
+			}
+		}
+
+		// Only usable while the CPU copy of the vertex data is around
+		if (Positions && Positions->GetNumVertices() > 0 && Positions->GetVertexData() && Positions->GetStride() == sizeof(FVector3f))
+		{
+			return Positions;
+		}
+		return nullptr;
+	}
+
+	static const UObject* GetSupportAsset(const UPrimitiveComponent* Component)
+	{
+		if (const UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Component))
+		{
+			if (StaticMeshComp->GetStaticMesh())
+			{
+				return StaticMeshComp->GetStaticMesh();
+			}
+		}
+		else if (const USkeletalMeshComponent* SkelMeshComp = Cast<USkeletalMeshComponent>(Component))
+		{
+			if (SkelMeshComp->GetSkeletalMeshAsset())
+			{
+				return SkelMeshComp->GetSkeletalMeshAsset();
+			}
+		}
+		return const_cast<UPrimitiveComponent*>(Component)->GetBodySetup();
+	}
+
+	// Min over the asset's LOD0 vertices (or its simple collision) of Dot(Point, Direction)
+	static bool CalcAssetSupport(const UPrimitiveComponent* Component, const FVector3f& Direction, float& OutMinDot)
+	{
+		if (const FPositionVertexBuffer* Positions = GetLOD0Positions(Component))
+		{
+			const TConstArrayView<FVector3f> Points(static_cast<const FVector3f*>(Positions->GetVertexData()), Positions->GetNumVertices());
+			OutMinDot = TransformKernels::MinDotProduct(Points, Direction);
+			return true;
+		}
+
+		const UBodySetup* BodySetup = const_cast<UPrimitiveComponent*>(Component)->GetBodySetup();
+		if (!BodySetup)
+		{
+			return false;
+		}
+
+		// Hull points, plus spheres for round elements (a capsule is the hull of its two end spheres)
+		const FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+		TArray<FVector3f> Points;
+		TArray<FVector4f, TInlineAllocator<8>> Spheres;
+
+		for (const FKConvexElem& Elem : AggGeom.ConvexElems)
+		{
+			const FTransform ElemTransform = Elem.GetTransform();
+			for (const FVector& Vertex : Elem.VertexData)
+			{
+				Points.Add(FVector3f(ElemTransform.TransformPosition(Vertex)));
+			}
+		}
+		for (const FKBoxElem& Elem : AggGeom.BoxElems)
+		{
+			const FTransform ElemTransform = Elem.GetTransform();
+			const FVector HalfExtent(Elem.X * 0.5f, Elem.Y * 0.5f, Elem.Z * 0.5f);
+			for (int32 Corner = 0; Corner < 8; Corner++)
+			{
+				const FVector Sign((Corner & 1) ? 1.0 : -1.0, (Corner & 2) ? 1.0 : -1.0, (Corner & 4) ? 1.0 : -1.0);
+				Points.Add(FVector3f(ElemTransform.TransformPosition(HalfExtent * Sign)));
+			}
+		}
+		for (const FKSphereElem& Elem : AggGeom.SphereElems)
+		{
+			Spheres.Add(FVector4f(FVector3f(Elem.Center), Elem.Radius));
+		}
+		for (const FKSphylElem& Elem : AggGeom.SphylElems)
+		{
+			const FTransform ElemTransform = Elem.GetTransform();
+			Spheres.Add(FVector4f(FVector3f(ElemTransform.TransformPosition(FVector(0, 0, Elem.Length * 0.5f))), Elem.Radius));
+			Spheres.Add(FVector4f(FVector3f(ElemTransform.TransformPosition(FVector(0, 0, -Elem.Length * 0.5f))), Elem.Radius));
+		}
+		for (const FKTaperedCapsuleElem& Elem : AggGeom.TaperedCapsuleElems)
+		{
+			const FTransform ElemTransform = Elem.GetTransform();
+			Spheres.Add(FVector4f(FVector3f(ElemTransform.TransformPosition(FVector(0, 0, Elem.Length * 0.5f))), Elem.Radius0));
+			Spheres.Add(FVector4f(FVector3f(ElemTransform.TransformPosition(FVector(0, 0, -Elem.Length * 0.5f))), Elem.Radius1));
+		}
+
+		if (Points.Num() == 0 && Spheres.Num() == 0)
+		{
+			return false;
+		}
+
+		OutMinDot = TransformKernels::MinDotProduct(Points, Direction);
+		for (const FVector4f& Sphere : Spheres)
+		{
+			OutMinDot = FMath::Min(OutMinDot, FVector3f::DotProduct(FVector3f(Sphere), Direction) - Sphere.W * Direction.Size());
+		}
+		return true;
+	}
+
+	// Min over the component's geometry of Dot(WorldPoint - ComponentOrigin, GroundNormal)
+	static bool CalcComponentSupport(const UPrimitiveComponent* Component, const FTransform& ComponentTransform, const FVector& GroundNormal, float& OutMinDot)
+	{
+		const UObject* Asset = GetSupportAsset(Component);
+		if (!Asset)
+		{
+			return false;
+		}
+
+		// Dot(R * (S * P), N) == Dot(P, S * R^-1 * N), so only the local direction matters
+		const FVector LocalDirection = ComponentTransform.GetScale3D() * ComponentTransform.InverseTransformVectorNoScale(GroundNormal);
+		const double DirectionLength = LocalDirection.Size();
+		if (DirectionLength < UE_SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		const FVector UnitDirection = LocalDirection / DirectionLength;
+		const FObjectKey AssetKey(Asset);
+		const FIntVector Direction(
+			FMath::RoundToInt(UnitDirection.X * SupportDirectionSteps),
+			FMath::RoundToInt(UnitDirection.Y * SupportDirectionSteps),
+			FMath::RoundToInt(UnitDirection.Z * SupportDirectionSteps));
+
+		if (const TMap<FIntVector, float>* AssetEntries = SupportCache.Find(AssetKey))
+		{
+			if (const float* Cached = AssetEntries->Find(Direction))
+			{
+				INC_DWORD_STAT(STAT_LevelEditorShortcuts_BottomOffsetCacheHits);
+				OutMinDot = *Cached * DirectionLength;
+				return true;
+			}
+		}
+
+		INC_DWORD_STAT(STAT_LevelEditorShortcuts_BottomOffsetCacheMisses);
+		const FVector3f QuantizedDirection = FVector3f(Direction) / SupportDirectionSteps;
+		float UnitMinDot = 0.0f;
+		if (!CalcAssetSupport(Component, QuantizedDirection, UnitMinDot))
+		{
+			return false;
+		}
+
+		if (NumSupportEntries >= CVarBottomOffsetCacheSize.GetValueOnGameThread())
+		{
+			SupportCache.Reset();
+			NumSupportEntries = 0;
+		}
+		SupportCache.FindOrAdd(AssetKey).Add(Direction, UnitMinDot);
+		NumSupportEntries++;
+
+		OutMinDot = UnitMinDot * DirectionLength;
+		return true;
+	}
+
+	static void ForgetSupport(const UObject* Asset)
+	{
+		if (Asset)
+		{
+			if (const TMap<FIntVector, float>* AssetEntries = SupportCache.Find(FObjectKey(Asset)))
+			{
+				NumSupportEntries -= AssetEntries->Num();
+				SupportCache.Remove(FObjectKey(Asset));
+			}
+		}
+	}
+
+	// Meshes and body setups change in place on edit, rebuild and reimport, and a shape component's
+	// extent rewrites its body setup; drop what was cached for the assets behind Object
+	static void InvalidateSupport(UObject* Object)
+	{
+		if (!Object || SupportCache.Num() == 0)
+		{
+			return;
+		}
+
+		TArray<UPrimitiveComponent*> PrimComps;
+		if (AActor* Actor = Cast<AActor>(Object))
+		{
+			Actor->GetComponents<UPrimitiveComponent>(PrimComps);
+		}
+		else if (UPrimitiveComponent* Comp = Cast<UPrimitiveComponent>(Object))
+		{
+			PrimComps.Add(Comp);
+		}
+		else
+		{
+			ForgetSupport(Object);
+
+			// Collision edits of a mesh land on its body setup, while the entry is keyed by the mesh
+			if (Object->IsA<UBodySetup>())
+			{
+				ForgetSupport(Object->GetOuter());
+			}
+			return;
+		}
+
+		for (UPrimitiveComponent* Comp : PrimComps)
+		{
+			ForgetSupport(GetSupportAsset(Comp));
+			ForgetSupport(Comp->GetBodySetup());
+		}
+	}
+
+	void Register()
+	{
+		PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([](UObject* Object, FPropertyChangedEvent&)
+		{
+			InvalidateSupport(Object);
+		});
+		if (UImportSubsystem* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr)
+		{
+			ReimportHandle = ImportSubsystem->OnAssetReimport.AddStatic(&InvalidateSupport);
+		}
+	}
+
+	void Unregister()
+	{
+		FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+		if (UImportSubsystem* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr)
+		{
+			ImportSubsystem->OnAssetReimport.Remove(ReimportHandle);
+		}
+		SupportCache.Reset();
+		NumSupportEntries = 0;
+	}
+
+	// All blocking primitives; meshes without collision only if there are none (root = ground if neither)
+	static void GetSupportComponents(AActor* Actor, TArray<UPrimitiveComponent*, TInlineAllocator<8>>& OutComps)
+	{
+		TArray<UPrimitiveComponent*> PrimComps;
+		Actor->GetComponents<UPrimitiveComponent>(PrimComps);
+		for (UPrimitiveComponent* Comp : PrimComps)
+		{
+			if (IsGroundCollision(Comp))
+			{
+				OutComps.Add(Comp);
+			}
+		}
+		if (OutComps.Num() == 0)
+		{
+			for (UPrimitiveComponent* Comp : PrimComps)
+			{
+				if (Comp->IsA<UStaticMeshComponent>() || Comp->IsA<USkeletalMeshComponent>())
+				{
+					OutComps.Add(Comp);
+				}
+			}
+		}
+	}
+
+	// Actor transform at its current location with the rotation the snap will apply
+	static FTransform GetFinalActorTransform(const AActor* Actor, const FQuat& FinalRotation)
+	{
+		return FTransform(FinalRotation, Actor->GetActorLocation(), Actor->GetActorScale3D());
+	}
+
+	float CalcBottomOffset(AActor* Actor, const FQuat& FinalRotation, const FVector& GroundNormal)
+	{
+		// Nearly vertical walls would blow up the division below
+		const FVector Normal = GroundNormal.Z > 0.1 ? GroundNormal.GetSafeNormal() : FVector::UpVector;
+
+		TArray<UPrimitiveComponent*, TInlineAllocator<8>> SupportComps;
+		GetSupportComponents(Actor, SupportComps);
+
+		// Components as they will sit once the actor has its final rotation
+		const FTransform CurrentActorTransform = Actor->GetActorTransform();
+		const FTransform FinalActorTransform = GetFinalActorTransform(Actor, FinalRotation);
+
+		bool bFound = false;
+		double MinDot = 0.0;
+		for (UPrimitiveComponent* Comp : SupportComps)
+		{
+			const FTransform ComponentTransform = Comp->GetComponentTransform().GetRelativeTransform(CurrentActorTransform) * FinalActorTransform;
+
+			float ComponentMinDot = 0.0f;
+			if (CalcComponentSupport(Comp, ComponentTransform, Normal, ComponentMinDot))
+			{
+				const double Dot = FVector::DotProduct(ComponentTransform.GetLocation() - FinalActorTransform.GetLocation(), Normal) + ComponentMinDot;
+				MinDot = bFound ? FMath::Min(MinDot, Dot) : Dot;
+				bFound = true;
+			}
+		}
+
+		// Raise the pivot along Z until the lowest point touches the ground plane through the hit
+		return bFound ? static_cast<float>(-MinDot / Normal.Z) : 0.0f;
+	}
+
+	FCollisionQueryParams MakeTraceParams(AActor* Actor)
+	{
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(LevelEditorShortcutsGroundSnap));
+		QueryParams.AddIgnoredActor(Actor);
+
+		// Recursively ignore all attached actors
+		TArray<AActor*> AttachedActors;
+		Actor->GetAttachedActors(AttachedActors, true, true);
+		for (AActor* Attached : AttachedActors)
+		{
+			QueryParams.AddIgnoredActor(Attached);
+		}
+
+		return QueryParams;
+	}
+
+	void GetFootprintStarts(const AActor* Actor, TArray<FVector, TInlineAllocator<16>>& OutStarts)
+	{
+		const FVector ActorLocation = Actor->GetActorLocation();
+		const FVector PivotStart = ActorLocation + FVector(0, 0, TraceStartHeight);
+
+		const int32 SamplesPerSide = FMath::Clamp(CVarSnapFootprintSamples.GetValueOnGameThread(), 1, 16);
+		FBox Bounds = Actor->GetComponentsBoundingBox(false, true);
+		if (!Bounds.IsValid)
+		{
+			Bounds = Actor->GetComponentsBoundingBox(true, true);
+		}
+
+		// Single ray at the pivot
+		if (SamplesPerSide == 1 || !Bounds.IsValid)
+		{
+			OutStarts.Add(PivotStart);
+			return;
+		}
+
+		// Grid over the projected bounds, pulled in a little so edge rays don't miss ledges the actor overhangs
+		const FVector Center = Bounds.GetCenter();
+		const FVector Extent = Bounds.GetExtent() * FootprintInset;
+		for (int32 Y = 0; Y < SamplesPerSide; Y++)
+		{
+			for (int32 X = 0; X < SamplesPerSide; X++)
+			{
+				const double U = 2.0 * X / (SamplesPerSide - 1) - 1.0;
+				const double V = 2.0 * Y / (SamplesPerSide - 1) - 1.0;
+				OutStarts.Add(FVector(Center.X + U * Extent.X, Center.Y + V * Extent.Y, PivotStart.Z));
+			}
+		}
+	}
+
+	bool FitGroundPlane(const AActor* Actor, TConstArrayView<FHitResult> Hits, FHitResult& OutHit)
+	{
+		if (Hits.Num() == 0)
+		{
+			return false;
+		}
+
+		// Pivot-only sample: the hit is the ground
+		if (Hits.Num() == 1)
+		{
+			OutHit = Hits[0];
+			return true;
+		}
+
+		// Least-squares plane z = A*x + B*y + C, relative to the pivot so C is the height under it
+		const FVector Pivot = Actor->GetActorLocation();
+		double Sxx = 0, Sxy = 0, Syy = 0, Sx = 0, Sy = 0, Sxz = 0, Syz = 0, Sz = 0;
+		for (const FHitResult& Hit : Hits)
+		{
+			const FVector P = Hit.ImpactPoint - Pivot;
+			Sxx += P.X * P.X; Sxy += P.X * P.Y; Syy += P.Y * P.Y;
+			Sx += P.X; Sy += P.Y;
+			Sxz += P.X * P.Z; Syz += P.Y * P.Z; Sz += P.Z;
+		}
+		const double N = Hits.Num();
+
+		const double Det = Sxx * (Syy * N - Sy * Sy) - Sxy * (Sxy * N - Sy * Sx) + Sx * (Sxy * Sy - Syy * Sx);
+
+		// Highest sample and averaged normal when the hits are collinear (e.g. a thin rail)
+		if (Hits.Num() < 3 || FMath::Abs(Det) < UE_KINDA_SMALL_NUMBER)
+		{
+			const FHitResult* Highest = &Hits[0];
+			FVector NormalSum = FVector::ZeroVector;
+			for (const FHitResult& Hit : Hits)
+			{
+				Highest = Hit.ImpactPoint.Z > Highest->ImpactPoint.Z ? &Hit : Highest;
+				NormalSum += Hit.ImpactNormal;
+			}
+			OutHit = *Highest;
+			OutHit.ImpactPoint = FVector(Pivot.X, Pivot.Y, Highest->ImpactPoint.Z);
+			OutHit.ImpactNormal = NormalSum.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+			return true;
+		}
+
+		// Cramer's rule on the normal equations
+		const double A = (Sxz * (Syy * N - Sy * Sy) - Sxy * (Syz * N - Sy * Sz) + Sx * (Syz * Sy - Syy * Sz)) / Det;
+		const double B = (Sxx * (Syz * N - Sy * Sz) - Sxz * (Sxy * N - Sy * Sx) + Sx * (Sxy * Sz - Syz * Sx)) / Det;
+		double C = (Sxx * (Syy * Sz - Sy * Syz) - Sxy * (Sxy * Sz - Sx * Syz) + Sxz * (Sxy * Sy - Syy * Sx)) / Det;
+
+		// Raise the fitted plane onto the highest sample so the actor rests on the bumps instead of sinking into them
+		double MaxResidual = -UE_BIG_NUMBER;
+		for (const FHitResult& Hit : Hits)
+		{
+			const FVector P = Hit.ImpactPoint - Pivot;
+			MaxResidual = FMath::Max(MaxResidual, P.Z - (A * P.X + B * P.Y + C));
+		}
+		C += MaxResidual;
+
+		OutHit = Hits[Hits.Num() / 2];
+		OutHit.ImpactPoint = FVector(Pivot.X, Pivot.Y, Pivot.Z + C);
+		OutHit.ImpactNormal = FVector(-A, -B, 1.0).GetSafeNormal();
+		OutHit.Location = OutHit.ImpactPoint;
+		OutHit.Normal = OutHit.ImpactNormal;
+		return true;
+	}
+
+	bool BlocksGroundTrace(const UPrimitiveComponent* Component)
+	{
+		// Same rule the old channel trace + re-trace loop applied: blocks ECC_Visibility,
+		// and isn't a query-only collider (blocks Visibility but no physics)
+		return IsGroundCollision(Component) && Component->GetCollisionResponseToChannel(ECC_Visibility) == ECR_Block;
+	}
+
+	static TUniquePtr<FLandscapeGroundSampler> MakeLandscapeSampler(UWorld* World, TConstArrayView<AActor*> Actors)
+	{
+		if (CVarLandscapeSnapFastPath.GetValueOnGameThread() == 0 || Actors.Num() < CVarLandscapeSnapMinActors.GetValueOnGameThread())
+		{
+			return nullptr;
+		}
+
+		// Footprint rays stay inside the actors' bounds; the margin covers the normal's neighbour samples
+		FBox Region(ForceInit);
+		for (const AActor* Actor : Actors)
+		{
+			Region += Actor->GetComponentsBoundingBox(true, true);
+			Region += Actor->GetActorLocation();
+		}
+
+		TUniquePtr<FLandscapeGroundSampler> Sampler = MakeUnique<FLandscapeGroundSampler>();
+		Sampler->Build(World, Region.ExpandBy(FVector(1000.0, 1000.0, 0.0)), Actors);
+		return Sampler->HasLandscape() ? MoveTemp(Sampler) : nullptr;
+	}
+
+	FHitResult MakeGroundHit(const FVector& TraceStart, double Height, const FVector& Normal)
+	{
+		FHitResult Hit;
+		Hit.bBlockingHit = true;
+		Hit.TraceStart = TraceStart;
+		Hit.TraceEnd = TraceStart - FVector(0, 0, TraceLength);
+		Hit.ImpactPoint = FVector(TraceStart.X, TraceStart.Y, Height);
+		Hit.Location = Hit.ImpactPoint;
+		Hit.ImpactNormal = Normal;
+		Hit.Normal = Normal;
+		Hit.Distance = TraceStart.Z - Height;
+		Hit.Time = Hit.Distance / TraceLength;
+		return Hit;
+	}
+
+	FGroundSources::FGroundSources() = default;
+	FGroundSources::~FGroundSources() = default;
+
+	bool FGroundSources::Sample(const FVector& TraceStart, FHitResult& OutHit) const
+	{
+		// Landscape first, so the cache never asks for tiles the heightfield already answers
+		return (Landscape && Landscape->Sample(TraceStart, OutHit)) || (HeightCache && HeightCache->Sample(TraceStart, OutHit));
+	}
+
+	void PrepareGroundSources(UWorld* World, TConstArrayView<AActor*> Actors, FGroundSources& OutSources)
+	{
+		OutSources.HeightCache = nullptr;
+		OutSources.Landscape.Reset();
+		if (UseSweep())
+		{
+			return;
+		}
+
+		FGroundHeightCache* HeightCache = FGroundHeightCache::Get();
+		if (HeightCache && Actors.Num() >= CVarHeightCacheMinActors.GetValueOnGameThread())
+		{
+			HeightCache->Prepare(World, Actors);
+			OutSources.HeightCache = HeightCache;
+		}
+
+		OutSources.Landscape = MakeLandscapeSampler(World, Actors);
+	}
+
+	FCollisionObjectQueryParams GetGroundObjectParams()
+	{
+		// Object queries report every hit as a touch, so blockers that don't count as ground
+		// don't end the query early like they do for a channel trace
+		return FCollisionObjectQueryParams(FCollisionObjectQueryParams::AllObjects);
+	}
+
+	const FHitResult* FindGroundHit(TConstArrayView<FHitResult> Hits, bool bSkipStartPenetrating, const FActorSet* PendingActors)
+	{
+		for (const FHitResult& Hit : Hits)
+		{
+			// Selected actors that haven't settled yet aren't ground for anything
+			if (PendingActors && PendingActors->Contains(Hit.GetActor()))
+			{
+				continue;
+			}
+
+			// A sweep that starts inside something can't rest on it
+			if (bSkipStartPenetrating && Hit.bStartPenetrating)
+			{
+				continue;
+			}
+
+			if (BlocksGroundTrace(Hit.GetComponent()))
+			{
+				return &Hit;
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool TraceGroundAt(UWorld* World, const FVector& TraceStart, const FCollisionQueryParams& QueryParams, FHitResult& OutHit, const FActorSet* PendingActors)
+	{
+		INC_DWORD_STAT(STAT_LevelEditorShortcuts_GroundSnapTraces);
+		TArray<FHitResult> Hits;
+		World->LineTraceMultiByObjectType(Hits, TraceStart, TraceStart - FVector(0, 0, TraceLength), GetGroundObjectParams(), QueryParams);
+
+		if (const FHitResult* GroundHit = FindGroundHit(Hits, false, PendingActors))
+		{
+			OutHit = *GroundHit;
+			return true;
+		}
+
+		return false;
+	}
+
+	bool TraceGround(UWorld* World, AActor* Actor, FHitResult& OutHit, const FActorSet* PendingActors, const FGroundSources* Sources)
+	{
+		TArray<FVector, TInlineAllocator<16>> Starts;
+		GetFootprintStarts(Actor, Starts);
+		const FCollisionQueryParams QueryParams = MakeTraceParams(Actor);
+
+		TArray<FHitResult, TInlineAllocator<16>> GroundHits;
+		for (const FVector& TraceStart : Starts)
+		{
+			FHitResult GroundHit;
+			if ((Sources && Sources->Sample(TraceStart, GroundHit)) || TraceGroundAt(World, TraceStart, QueryParams, GroundHit, PendingActors))
+			{
+				GroundHits.Add(GroundHit);
+			}
+		}
+
+		return FitGroundPlane(Actor, GroundHits, OutHit);
+	}
+
+	FRotator AlignToSurface(const FRotator& CurrentRotation, const FVector& SurfaceNormal)
+	{
+		// Actor's current forward direction (on XY plane)
+		FVector CurrentForward = CurrentRotation.Vector();
+		CurrentForward.Z = 0;
+		CurrentForward.Normalize();
+
+		// NewUp = surface normal
+		// NewForward = current forward projected onto the surface plane
+		FVector NewUp = SurfaceNormal;
+		FVector NewRight = FVector::CrossProduct(NewUp, CurrentForward);
+		NewRight.Normalize();
+		FVector NewForward = FVector::CrossProduct(NewRight, NewUp);
+		NewForward.Normalize();
+
+		FMatrix RotationMatrix = FMatrix::Identity;
+		RotationMatrix.SetAxes(&NewForward, &NewRight, &NewUp);
+		return RotationMatrix.Rotator();
+	}
+
+	bool UseSweep()
+	{
+		return CVarSnapSweepShapes.GetValueOnGameThread() != 0;
+	}
+
+	void GetSweepShapes(AActor* Actor, const FQuat& FinalRotation, TArray<FSweepShape, TInlineAllocator<8>>& OutShapes)
+	{
+		TArray<UPrimitiveComponent*, TInlineAllocator<8>> SupportComps;
+		GetSupportComponents(Actor, SupportComps);
+
+		const FTransform CurrentActorTransform = Actor->GetActorTransform();
+		const FTransform FinalActorTransform = GetFinalActorTransform(Actor, FinalRotation);
+		const FVector Pivot = FinalActorTransform.GetLocation();
+
+		auto AddBox = [&OutShapes, &Pivot](const FVector& Center, const FQuat& Rotation, const FVector& HalfExtent)
+		{
+			OutShapes.Add({ FCollisionShape::MakeBox(HalfExtent), Rotation, Center - Pivot });
+		};
+
+		for (UPrimitiveComponent* Comp : SupportComps)
+		{
+			const FTransform ComponentTransform = Comp->GetComponentTransform().GetRelativeTransform(CurrentActorTransform) * FinalActorTransform;
+			const FVector Scale = ComponentTransform.GetScale3D().GetAbs();
+			const FQuat ComponentRotation = ComponentTransform.GetRotation();
+
+			const UBodySetup* BodySetup = Comp->GetBodySetup();
+			const int32 NumShapesBefore = OutShapes.Num();
+			if (BodySetup)
+			{
+				const FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+				for (const FKBoxElem& Elem : AggGeom.BoxElems)
+				{
+					AddBox(ComponentTransform.TransformPosition(Elem.Center), ComponentRotation * Elem.Rotation.Quaternion(),
+						FVector(Elem.X, Elem.Y, Elem.Z) * 0.5 * Scale);
+				}
+				for (const FKSphereElem& Elem : AggGeom.SphereElems)
+				{
+					OutShapes.Add({ FCollisionShape::MakeSphere(Elem.Radius * Scale.GetMax()), FQuat::Identity,
+						ComponentTransform.TransformPosition(Elem.Center) - Pivot });
+				}
+				for (const FKSphylElem& Elem : AggGeom.SphylElems)
+				{
+					const FTransform ElemTransform = Elem.GetTransform();
+					OutShapes.Add({ FCollisionShape::MakeCapsule(Elem.Radius * FMath::Max(Scale.X, Scale.Y), (Elem.Length * 0.5f + Elem.Radius) * Scale.Z),
+						ComponentRotation * ElemTransform.GetRotation(), ComponentTransform.TransformPosition(ElemTransform.GetLocation()) - Pivot });
+				}
+				for (const FKTaperedCapsuleElem& Elem : AggGeom.TaperedCapsuleElems)
+				{
+					const FTransform ElemTransform = Elem.GetTransform();
+					const float Radius = FMath::Max(Elem.Radius0, Elem.Radius1);
+					OutShapes.Add({ FCollisionShape::MakeCapsule(Radius * FMath::Max(Scale.X, Scale.Y), (Elem.Length * 0.5f + Radius) * Scale.Z),
+						ComponentRotation * ElemTransform.GetRotation(), ComponentTransform.TransformPosition(ElemTransform.GetLocation()) - Pivot });
+				}
+				// Convex hulls sweep as their oriented bounding box
+				for (const FKConvexElem& Elem : AggGeom.ConvexElems)
+				{
+					const FTransform ElemTransform = Elem.GetTransform();
+					AddBox(ComponentTransform.TransformPosition(ElemTransform.TransformPosition(Elem.ElemBox.GetCenter())),
+						ComponentRotation * ElemTransform.GetRotation(), Elem.ElemBox.GetExtent() * Scale);
+				}
+			}
+
+			// No simple collision (or a render-only mesh): its oriented local bounds
+			if (OutShapes.Num() == NumShapesBefore)
+			{
+				const FBoxSphereBounds LocalBounds = Comp->CalcLocalBounds();
+				AddBox(ComponentTransform.TransformPosition(LocalBounds.Origin), ComponentRotation, LocalBounds.BoxExtent * Scale);
+			}
+		}
+
+		// Too many pieces to sweep one by one: the actor's oriented bounds instead
+		if (OutShapes.Num() > MaxSweepShapes)
+		{
+			OutShapes.Reset();
+			const FBox LocalBox = Actor->CalculateComponentsBoundingBoxInLocalSpace(false, false);
+			if (LocalBox.IsValid)
+			{
+				AddBox(FinalActorTransform.TransformPosition(LocalBox.GetCenter()), FinalRotation, LocalBox.GetExtent() * FinalActorTransform.GetScale3D().GetAbs());
+			}
+		}
+	}
+
+	bool SweepGroundAt(UWorld* World, const FVector& SweepStart, const FSweepShape& Shape, const FCollisionQueryParams& QueryParams, FHitResult& OutHit, const FActorSet* PendingActors)
+	{
+		INC_DWORD_STAT(STAT_LevelEditorShortcuts_GroundSnapTraces);
+		TArray<FHitResult> Hits;
+		World->SweepMultiByObjectType(Hits, SweepStart, SweepStart - FVector(0, 0, TraceLength), Shape.Rotation, GetGroundObjectParams(), Shape.Shape, QueryParams);
+
+		if (const FHitResult* GroundHit = FindGroundHit(Hits, true, PendingActors))
+		{
+			OutHit = *GroundHit;
+			return true;
+		}
+
+		return false;
+	}
+
+	bool SweepGround(UWorld* World, AActor* Actor, const FQuat& FinalRotation, double& OutDropDistance, const FActorSet* PendingActors)
+	{
+		TArray<FSweepShape, TInlineAllocator<8>> Shapes;
+		GetSweepShapes(Actor, FinalRotation, Shapes);
+		const FCollisionQueryParams QueryParams = MakeTraceParams(Actor);
+		const FVector SweepOrigin = Actor->GetActorLocation() + FVector(0, 0, TraceStartHeight);
+
+		// Every shape moves down together; the first one to make contact stops the actor
+		bool bHit = false;
+		for (const FSweepShape& Shape : Shapes)
+		{
+			FHitResult Hit;
+			if (SweepGroundAt(World, SweepOrigin + Shape.Offset, Shape, QueryParams, Hit, PendingActors))
+			{
+				OutDropDistance = bHit ? FMath::Min(OutDropDistance, (double)Hit.Distance) : Hit.Distance;
+				bHit = true;
+			}
+		}
+		return bHit;
+	}
+
+	bool SnapActor(UWorld* World, AActor* Actor, bool bAlignToSurface, const FActorSet* PendingActors, const FGroundSources* Sources)
+	{
+		const bool bSweep = UseSweep();
+
+		// Line mode, or the slope for an aligned sweep: footprint traces
+		FRotator NewRotation = FRotator::ZeroRotator;
+		if (!bSweep || bAlignToSurface)
+		{
+			FHitResult GroundHit;
+			if (!TraceGround(World, Actor, GroundHit, PendingActors, Sources))
+			{
+				return false;
+			}
+			if (!bSweep)
+			{
+				ApplySnap(Actor, GroundHit, bAlignToSurface);
+				return true;
+			}
+			NewRotation = AlignToSurface(Actor->GetActorRotation(), GroundHit.ImpactNormal);
+		}
+
+		// Sweep the collision shapes already in their final orientation, rest at first contact
+		double DropDistance = 0.0;
+		if (!SweepGround(World, Actor, NewRotation.Quaternion(), DropDistance, PendingActors))
+		{
+			return false;
+		}
+
+		ApplySnapTransform(Actor, Actor->GetActorLocation() + FVector(0, 0, TraceStartHeight - DropDistance), NewRotation);
+		return true;
+	}
+
+	int32 BuildSupportLayers(TConstArrayView<AActor*> Actors, TArray<int32>& OutLayers)
+	{
+		const int32 NumActors = Actors.Num();
+		OutLayers.Init(0, NumActors);
+		if (NumActors < 2)
+		{
+			return NumActors;
+		}
+
+		TArray<FBox> Bounds;
+		Bounds.SetNumUninitialized(NumActors);
+		TArray<double> FootprintSizes;
+		FootprintSizes.SetNumUninitialized(NumActors);
+		for (int32 i = 0; i < NumActors; i++)
+		{
+			FBox Box = Actors[i]->GetComponentsBoundingBox(false, true);
+			if (!Box.IsValid)
+			{
+				Box = Actors[i]->GetComponentsBoundingBox(true, true);
+			}
+			if (!Box.IsValid)
+			{
+				Box = FBox(Actors[i]->GetActorLocation(), Actors[i]->GetActorLocation());
+			}
+
+			// Footprints that only touch at the edges don't support each other
+			const FVector Shrink(FMath::Min(1.0, Box.GetExtent().X * 0.5), FMath::Min(1.0, Box.GetExtent().Y * 0.5), 0.0);
+			Bounds[i] = FBox(Box.Min + Shrink, Box.Max - Shrink);
+			FootprintSizes[i] = FMath::Max(Bounds[i].GetSize().X, Bounds[i].GetSize().Y);
+		}
+
+		// XY hash grid sized to a typical footprint so each actor only checks its neighbours
+		TArray<double> SortedSizes = FootprintSizes;
+		SortedSizes.Sort();
+		const double CellSize = FMath::Clamp(SortedSizes[NumActors / 2] * 2.0, 50.0, 100000.0);
+		auto ToCell = [CellSize](double Value) { return FMath::FloorToInt32(Value / CellSize); };
+
+		// Bottom-up: everything an actor can rest on has been placed in the grid before it
+		TArray<int32> Order;
+		Order.SetNumUninitialized(NumActors);
+		for (int32 i = 0; i < NumActors; i++)
+		{
+			Order[i] = i;
+		}
+		Order.Sort([&Bounds](int32 A, int32 B) { return Bounds[A].Min.Z < Bounds[B].Min.Z; });
+
+		TMap<FIntPoint, TArray<int32>> Grid;
+		TArray<int32> LargeActors;
+		TArray<int32> Processed;
+		TArray<int32> VisitStamp;
+		VisitStamp.Init(INDEX_NONE, NumActors);
+		int32 NumLayers = 1;
+
+		for (int32 Upper : Order)
+		{
+			const FBox& UpperBox = Bounds[Upper];
+			auto ConsiderSupport = [&](int32 Lower)
+			{
+				if (VisitStamp[Lower] == Upper)
+				{
+					return;
+				}
+				VisitStamp[Lower] = Upper;
+
+				const FBox& LowerBox = Bounds[Lower];
+				const bool bOverlapXY = LowerBox.Min.X < UpperBox.Max.X && UpperBox.Min.X < LowerBox.Max.X
+					&& LowerBox.Min.Y < UpperBox.Max.Y && UpperBox.Min.Y < LowerBox.Max.Y;
+				if (bOverlapXY && LowerBox.Min.Z + StackTolerance < UpperBox.Min.Z && LowerBox.GetCenter().Z < UpperBox.GetCenter().Z)
+				{
+					OutLayers[Upper] = FMath::Max(OutLayers[Upper], OutLayers[Lower] + 1);
+				}
+			};
+
+			const FIntPoint MinCell(ToCell(UpperBox.Min.X), ToCell(UpperBox.Min.Y));
+			const FIntPoint MaxCell(ToCell(UpperBox.Max.X), ToCell(UpperBox.Max.Y));
+			const int64 NumCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+			const bool bLarge = NumCells > MaxStackCellsPerActor;
+
+			// Floors, terrain pieces, etc. covering many cells are checked against everything instead
+			for (int32 Lower : LargeActors)
+			{
+				ConsiderSupport(Lower);
+			}
+			if (bLarge)
+			{
+				for (int32 Lower : Processed)
+				{
+					ConsiderSupport(Lower);
+				}
+				LargeActors.Add(Upper);
+			}
+			else
+			{
+				for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+				{
+					for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+					{
+						if (const TArray<int32>* Cell = Grid.Find(FIntPoint(X, Y)))
+						{
+							for (int32 Lower : *Cell)
+							{
+								ConsiderSupport(Lower);
+							}
+						}
+					}
+				}
+				for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+				{
+					for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+					{
+						Grid.FindOrAdd(FIntPoint(X, Y)).Add(Upper);
+					}
+				}
+			}
+
+			Processed.Add(Upper);
+			NumLayers = FMath::Max(NumLayers, OutLayers[Upper] + 1);
+		}
+
+		return NumLayers;
+	}
+
+	double CalcRestingHeight(AActor* Actor, const FQuat& Rotation, const FHitResult& Hit)
+	{
+		// Small clearance so the lowest vertex doesn't z-fight or start penetrating the ground
+		return Hit.ImpactPoint.Z + CalcBottomOffset(Actor, Rotation, Hit.ImpactNormal) + 5.0f;
+	}
+
+	void CalcSnapTransform(AActor* Actor, const FHitResult& Hit, bool bAlignToSurface, FVector& OutLocation, FRotator& OutRotation)
+	{
+		// Inherit the surface slope, or reset to world up
+		OutRotation = bAlignToSurface ? AlignToSurface(Actor->GetActorRotation(), Hit.ImpactNormal) : FRotator::ZeroRotator;
+
+		OutLocation = Actor->GetActorLocation();
+		OutLocation.Z = CalcRestingHeight(Actor, OutRotation.Quaternion(), Hit);
+	}
+
+	void ApplySnap(AActor* Actor, const FHitResult& Hit, bool bAlignToSurface)
+	{
+		FVector NewLocation;
+		FRotator NewRotation;
+		CalcSnapTransform(Actor, Hit, bAlignToSurface, NewLocation, NewRotation);
+		ApplySnapTransform(Actor, NewLocation, NewRotation);
+	}
+
+	void ApplySnapTransform(AActor* Actor, const FVector& NewLocation, const FRotator& NewRotation)
+	{
+		Actor->Modify();
+		Actor->SetActorLocation(NewLocation);
+		Actor->SetActorRotation(NewRotation);
+		Actor->PostEditMove(true);
+	}
+}
+
+FGroundSnapBatch::~FGroundSnapBatch()
+{
+	// Torn down mid-batch: early moves were never recorded, so don't leave them behind
+	RestoreMovedActors();
+	CloseNotification(false);
+}
+
+bool FGroundSnapBatch::Start(UWorld* InWorld, TConstArrayView<AActor*> Actors, bool bInAlignToSurface, const FText& InTransactionText)
+{
+	World = InWorld;
+	bAlignToSurface = bInAlignToSurface;
+	TransactionText = InTransactionText;
+
+	bSweep = GroundSnap::UseSweep();
+
+	Requests.Reserve(Actors.Num());
+	for (AActor* Actor : Actors)
+	{
+		FRequest& Request = Requests.AddDefaulted_GetRef();
+		Request.Actor = Actor;
+		Request.Params = GroundSnap::MakeTraceParams(Actor);
+		PendingActors.Add(Actor);
+	}
+
+	if (Requests.Num() == 0)
+	{
+		return false;
+	}
+
+	GroundSnap::PrepareGroundSources(InWorld, Actors, Sources);
+
+	// Bottom-up layers: each one is traced against the already snapped layers below it
+	TArray<int32> Layers;
+	LayerRequests.SetNum(GroundSnap::BuildSupportLayers(Actors, Layers));
+	for (int32 i = 0; i < Layers.Num(); i++)
+	{
+		LayerRequests[Layers[i]].Add(i);
+	}
+
+	TraceDelegate.BindSP(this, &FGroundSnapBatch::OnTraceCompleted);
+
+	if (Requests.Num() >= CVarAsyncSnapProgressThreshold.GetValueOnGameThread())
+	{
+		FNotificationInfo Info(FText::GetEmpty());
+		Info.bFireAndForget = false;
+		Info.ButtonDetails.Add(FNotificationButtonInfo(
+			FText::FromString(TEXT("Cancel")),
+			FText::FromString(TEXT("Stop snapping and leave all actors where they are")),
+			FSimpleDelegate::CreateSP(this, &FGroundSnapBatch::Cancel),
+			SNotificationItem::CS_Pending));
+		Notification = FSlateNotificationManager::Get().AddNotification(Info);
+		if (Notification.IsValid())
+		{
+			Notification->SetCompletionState(SNotificationItem::CS_Pending);
+		}
+		UpdateProgress();
+	}
+
+	QueueLayer();
+	SubmitPending();
+	return true;
+}
+
+bool FGroundSnapBatch::Tick()
+{
+	if (bCancelled)
+	{
+		return false;
+	}
+
+	if (!World.IsValid())
+	{
+		Cancel();
+		return false;
+	}
+
+	SubmitPending();
+
+	// Resolve each layer as soon as it's complete so the next one traces against it
+	while (NumLayerPending == 0)
+	{
+		ResolveLayer();
+		if (++CurrentLayer == LayerRequests.Num())
+		{
+			Finish();
+			return false;
+		}
+		QueueLayer();
+		SubmitPending();
+	}
+
+	UpdateProgress();
+	return true;
+}
+
+void FGroundSnapBatch::Cancel()
+{
+	if (bCancelled)
+	{
+		return;
+	}
+
+	// Late trace results are dropped in OnTraceCompleted. Nothing was recorded yet; layers
+	// already moved for the ones above go back to where they started.
+	bCancelled = true;
+	const int32 NumRestored = RestoreMovedActors();
+	CloseNotification(false);
+
+	if (NumRestored > 0 && GEditor)
+	{
+		GEditor->NoteSelectionChange();
+		GEditor->RedrawLevelEditingViewports();
+	}
+}
+
+void FGroundSnapBatch::SubmitPending()
+{
+	UWorld* TraceWorld = World.Get();
+	if (!TraceWorld)
+	{
+		return;
+	}
+
+	const int32 MaxPerFrame = FMath::Max(1, CVarAsyncSnapTracesPerFrame.GetValueOnGameThread());
+	const int32 NumToSubmit = FMath::Min(PendingSubmit.Num(), MaxPerFrame);
+	for (int32 i = 0; i < NumToSubmit; i++)
+	{
+		const int32 SampleIndex = PendingSubmit.Pop(EAllowShrinking::No);
+		const FSample& Sample = Samples[SampleIndex];
+		const FVector SampleEnd = Sample.TraceStart - FVector(0, 0, GroundSnap::TraceLength);
+
+		INC_DWORD_STAT(STAT_LevelEditorShortcuts_GroundSnapTraces);
+		if (Sample.bSweep)
+		{
+			TraceWorld->AsyncSweepByObjectType(EAsyncTraceType::Multi, Sample.TraceStart, SampleEnd, Sample.Shape.Rotation,
+				GroundSnap::GetGroundObjectParams(), Sample.Shape.Shape, Requests[Sample.RequestIndex].Params,
+				&TraceDelegate, static_cast<uint32>(SampleIndex));
+		}
+		else
+		{
+			TraceWorld->AsyncLineTraceByObjectType(EAsyncTraceType::Multi, Sample.TraceStart, SampleEnd,
+				GroundSnap::GetGroundObjectParams(), Requests[Sample.RequestIndex].Params,
+				&TraceDelegate, static_cast<uint32>(SampleIndex));
+		}
+		NumInFlight++;
+	}
+}
+
+void FGroundSnapBatch::AddSample(FSample&& Sample)
+{
+	PendingSubmit.Add(Samples.Num());
+	Samples.Add(MoveTemp(Sample));
+}
+
+bool FGroundSnapBatch::QueueSweeps(int32 RequestIndex)
+{
+	FRequest& Request = Requests[RequestIndex];
+	AActor* Actor = Request.Actor.Get();
+	if (!IsValid(Actor))
+	{
+		return false;
+	}
+
+	TArray<GroundSnap::FSweepShape, TInlineAllocator<8>> Shapes;
+	GroundSnap::GetSweepShapes(Actor, Request.FinalRotation.Quaternion(), Shapes);
+
+	Request.SweepPivot = Actor->GetActorLocation();
+	Request.NumSamplesPending = Shapes.Num();
+	const FVector SweepOrigin = Request.SweepPivot + FVector(0, 0, GroundSnap::TraceStartHeight);
+	for (const GroundSnap::FSweepShape& Shape : Shapes)
+	{
+		AddSample({ RequestIndex, SweepOrigin + Shape.Offset, true, Shape });
+	}
+	return Shapes.Num() > 0;
+}
+
+void FGroundSnapBatch::OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	if (bCancelled || !Samples.IsValidIndex(static_cast<int32>(Datum.UserData)))
+	{
+		return;
+	}
+
+	// Copy out: queueing sweeps below can grow Samples
+	const int32 RequestIndex = Samples[static_cast<int32>(Datum.UserData)].RequestIndex;
+	const bool bSweepSample = Samples[static_cast<int32>(Datum.UserData)].bSweep;
+	FRequest& Request = Requests[RequestIndex];
+	NumInFlight--;
+
+	if (bSweepSample)
+	{
+		// Every shape drops together; the first contact stops the actor
+		if (const FHitResult* GroundHit = GroundSnap::FindGroundHit(Datum.OutHits, true, &PendingActors))
+		{
+			Request.DropDistance = Request.bHasDrop ? FMath::Min(Request.DropDistance, (double)GroundHit->Distance) : GroundHit->Distance;
+			Request.bHasDrop = true;
+		}
+	}
+	else if (const FHitResult* GroundHit = GroundSnap::FindGroundHit(Datum.OutHits, false, &PendingActors))
+	{
+		Request.GroundHits.Add(*GroundHit);
+	}
+
+	if (--Request.NumSamplesPending > 0 || ContinueRequest(RequestIndex, bSweepSample))
+	{
+		return;
+	}
+
+	NumFinished++;
+	NumLayerPending--;
+}
+
+bool FGroundSnapBatch::ContinueRequest(int32 RequestIndex, bool bSweepPhase)
+{
+	// Footprint done for an aligned sweep: sweep again in the surface orientation
+	if (bSweep && !bSweepPhase)
+	{
+		FRequest& Request = Requests[RequestIndex];
+		AActor* Actor = Request.Actor.Get();
+		FHitResult GroundHit;
+		if (IsValid(Actor) && GroundSnap::FitGroundPlane(Actor, Request.GroundHits, GroundHit))
+		{
+			Request.FinalRotation = GroundSnap::AlignToSurface(Actor->GetActorRotation(), GroundHit.ImpactNormal);
+			return QueueSweeps(RequestIndex);
+		}
+	}
+	return false;
+}
+
+void FGroundSnapBatch::QueueLayer()
+{
+	// Footprints are taken now, after any lower layer (and anything attached to it) has moved
+	NumLayerPending = 0;
+	TArray<FVector, TInlineAllocator<16>> Starts;
+	for (int32 RequestIndex : LayerRequests[CurrentLayer])
+	{
+		FRequest& Request = Requests[RequestIndex];
+		AActor* Actor = Request.Actor.Get();
+		if (!IsValid(Actor))
+		{
+			NumFinished++;
+			continue;
+		}
+
+		// Upright sweeps know their final rotation already; aligned ones need the footprint's slope first
+		if (bSweep && !bAlignToSurface)
+		{
+			if (QueueSweeps(RequestIndex))
+			{
+				NumLayerPending++;
+			}
+			else
+			{
+				NumFinished++;
+			}
+			continue;
+		}
+
+		// Bottom layer columns that only hold landscape are read from the heightfield right away
+		Starts.Reset();
+		GroundSnap::GetFootprintStarts(Actor, Starts);
+		Request.NumSamplesPending = 0;
+		for (const FVector& Start : Starts)
+		{
+			FHitResult SourceHit;
+			if (CurrentLayer == 0 && Sources.Sample(Start, SourceHit))
+			{
+				Request.GroundHits.Add(SourceHit);
+				continue;
+			}
+			AddSample({ RequestIndex, Start });
+			Request.NumSamplesPending++;
+		}
+
+		if (Request.NumSamplesPending > 0 || ContinueRequest(RequestIndex, false))
+		{
+			NumLayerPending++;
+		}
+		else
+		{
+			NumFinished++;
+		}
+	}
+}
+
+void FGroundSnapBatch::ResolveLayer()
+{
+	const bool bMoveNow = CurrentLayer + 1 < LayerRequests.Num();
+
+	for (int32 RequestIndex : LayerRequests[CurrentLayer])
+	{
+		FRequest& Request = Requests[RequestIndex];
+		AActor* Actor = Request.Actor.Get();
+		PendingActors.Remove(Actor);
+		if (!IsValid(Actor))
+		{
+			continue;
+		}
+
+		if (bSweep)
+		{
+			if (!Request.bHasDrop)
+			{
+				continue;
+			}
+			Request.FinalLocation = Request.SweepPivot + FVector(0, 0, GroundSnap::TraceStartHeight - Request.DropDistance);
+		}
+		else
+		{
+			FHitResult GroundHit;
+			if (!GroundSnap::FitGroundPlane(Actor, Request.GroundHits, GroundHit))
+			{
+				continue;
+			}
+			GroundSnap::CalcSnapTransform(Actor, GroundHit, bAlignToSurface, Request.FinalLocation, Request.FinalRotation);
+		}
+		Request.bResolved = true;
+
+		// Only the transform (and the physics body with it); PostEditMove runs once in Finish
+		if (bMoveNow)
+		{
+			Request.StartTransform = Actor->GetActorTransform();
+			Request.bMovedEarly = true;
+			Actor->SetActorLocationAndRotation(Request.FinalLocation, Request.FinalRotation);
+		}
+	}
+}
+
+int32 FGroundSnapBatch::RestoreMovedActors()
+{
+	int32 NumRestored = 0;
+	for (FRequest& Request : Requests)
+	{
+		if (!Request.bMovedEarly)
+		{
+			continue;
+		}
+		Request.bMovedEarly = false;
+
+		AActor* Actor = Request.Actor.Get();
+		if (!IsValid(Actor))
+		{
+			continue;
+		}
+
+		// Something else moved it while the batch ran - that edit wins
+		if (!Actor->GetActorLocation().Equals(Request.FinalLocation, 0.01) || !Actor->GetActorQuat().Equals(Request.FinalRotation.Quaternion(), 1.e-4f))
+		{
+			Request.bResolved = false;
+			continue;
+		}
+
+		Actor->SetActorTransform(Request.StartTransform);
+		NumRestored++;
+	}
+	return NumRestored;
+}
+
+void FGroundSnapBatch::Finish()
+{
+	// Back to the start first so the transaction records where every actor was
+	RestoreMovedActors();
+
+	int32 NumSnapped = 0;
+	{
+		FScopedTransaction Transaction(TransactionText);
+		for (const FRequest& Request : Requests)
+		{
+			AActor* Actor = Request.Actor.Get();
+			if (Request.bResolved && IsValid(Actor))
+			{
+				GroundSnap::ApplySnapTransform(Actor, Request.FinalLocation, Request.FinalRotation);
+				NumSnapped++;
+			}
+		}
+		if (NumSnapped == 0)
+		{
+			Transaction.Cancel();
+		}
+	}
+
+	CloseNotification(true, NumSnapped);
+
+	if (NumSnapped > 0 && GEditor)
+	{
+		GEditor->NoteSelectionChange();
+		GEditor->RedrawLevelEditingViewports();
+	}
+}
+
+void FGroundSnapBatch::UpdateProgress()
+{
+	if (Notification.IsValid())
+	{
+		Notification->SetText(FText::Format(FText::FromString(TEXT("Snapping to ground... {0} / {1} (Esc to cancel)")),
+			FText::AsNumber(NumFinished), FText::AsNumber(Requests.Num())));
+	}
+}
+
+void FGroundSnapBatch::CloseNotification(bool bSuccess, int32 NumSnapped)
+{
+	if (Notification.IsValid())
+	{
+		Notification->SetText(bSuccess
+			? FText::Format(FText::FromString(TEXT("Snapped {0} actors to ground")), FText::AsNumber(NumSnapped))
+			: FText::FromString(TEXT("Snap to ground cancelled")));
+		Notification->SetCompletionState(bSuccess ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+		Notification->ExpireAndFadeout();
+		Notification.Reset();
+	}
+}
+
+// LevelEditorShortcuts.BenchmarkGroundTrace - the single multi-hit ground query vs the old
+// channel trace + re-trace loop, for a pivot ray under every selected actor. Run it in a level with layered
+// trigger volumes above the ground to see the trace-count reduction.
+static void RunGroundTraceBenchmark()
+{
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	USelection* Selection = GEditor ? GEditor->GetSelectedActors() : nullptr;
+	if (!World || !Selection)
+	{
+		return;
+	}
+
+	int32 NumActors = 0;
+	int32 LegacyTraces = 0;
+	int32 NumMismatches = 0;
+	double LegacySeconds = 0.0;
+	double MultiSeconds = 0.0;
+
+	for (int32 i = 0; i < Selection->Num(); i++)
+	{
+		AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i));
+		if (!Actor)
+		{
+			continue;
+		}
+		NumActors++;
+
+		const FVector TraceStart = Actor->GetActorLocation() + FVector(0, 0, GroundSnap::TraceStartHeight);
+		const FVector TraceEnd = TraceStart - FVector(0, 0, GroundSnap::TraceLength);
+
+		// The loop this replaced: trace, skip query-only hits, trace again (up to 50 times)
+		double StartTime = FPlatformTime::Seconds();
+		FCollisionQueryParams QueryParams = GroundSnap::MakeTraceParams(Actor);
+		FHitResult LegacyHit;
+		bool bLegacyHit = false;
+		for (int32 Attempt = 0; Attempt < 50; Attempt++)
+		{
+			LegacyTraces++;
+			if (!World->LineTraceSingleByChannel(LegacyHit, TraceStart, TraceEnd, ECC_Visibility, QueryParams))
+			{
+				break;
+			}
+			if (GroundSnap::IsGroundCollision(LegacyHit.GetComponent()))
+			{
+				bLegacyHit = true;
+				break;
+			}
+			if (UPrimitiveComponent* HitComp = LegacyHit.GetComponent())
+			{
+				QueryParams.AddIgnoredComponent(HitComp);
+			}
+		}
+		LegacySeconds += FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		FHitResult GroundHit;
+		const bool bGroundHit = GroundSnap::TraceGroundAt(World, TraceStart, GroundSnap::MakeTraceParams(Actor), GroundHit);
+		MultiSeconds += FPlatformTime::Seconds() - StartTime;
+
+		if (bLegacyHit != bGroundHit || (bGroundHit && !FMath::IsNearlyEqual(LegacyHit.ImpactPoint.Z, GroundHit.ImpactPoint.Z, 0.1)))
+		{
+			NumMismatches++;
+		}
+	}
+
+	UE_LOG(LogLevelEditorShortcuts, Display, TEXT("Ground trace: %d actors, re-trace loop %d traces %.3f ms -> multi-hit %d traces %.3f ms, %d different results"),
+		NumActors, LegacyTraces, LegacySeconds * 1000.0, NumActors, MultiSeconds * 1000.0, NumMismatches);
+}
+
+static FAutoConsoleCommand BenchmarkGroundTraceCommand(
+	TEXT("LevelEditorShortcuts.BenchmarkGroundTrace"),
+	TEXT("Compares the single multi-hit ground snap query against the old 50-attempt re-trace loop for the selected actors."),
+	FConsoleCommandDelegate::CreateStatic(&RunGroundTraceBenchmark));
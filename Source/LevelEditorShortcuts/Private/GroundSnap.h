@@ -0,0 +1,233 @@
+// GroundSnap.h
+// Ground snap helpers shared by the shortcut processors:
+// collision filter rules, mesh bottom offsets, surface alignment,
+// and a batched asynchronous snap for large selections.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "Engine/HitResult.h"
+#include "WorldCollision.h"
+
+class AActor;
+class UPrimitiveComponent;
+class UWorld;
+class SNotificationItem;
+class FLandscapeGroundSampler;
+class FGroundHeightCache;
+
+namespace GroundSnap
+{
+	// Traces start this far above the actor and run this far down
+	constexpr float TraceStartHeight = 500.0f;
+	constexpr float TraceLength = 200000.0f;
+
+	// Only components with physics collision count as ground (skips query-only triggers, volumes, etc.)
+	bool IsGroundCollision(const UPrimitiveComponent* Component);
+
+	// Object types the ground query collects; every hit along the ray comes back as a touch
+	FCollisionObjectQueryParams GetGroundObjectParams();
+
+	// Selected actors that haven't been snapped yet (stacked snaps); hits on them are skipped
+	using FActorSet = TSet<const AActor*>;
+
+	// Blocks ECC_Visibility and has physics collision
+	bool BlocksGroundTrace(const UPrimitiveComponent* Component);
+
+	// First hit (in trace order) that passes BlocksGroundTrace
+	const FHitResult* FindGroundHit(TConstArrayView<FHitResult> Hits, bool bSkipStartPenetrating = false, const FActorSet* PendingActors = nullptr);
+
+	// Height of the actor's origin above a ground plane with the given normal once the actor has
+	// FinalRotation, so its lowest LOD0/collision vertex touches the plane. Cached per mesh and orientation.
+	float CalcBottomOffset(AActor* Actor, const FQuat& FinalRotation, const FVector& GroundNormal);
+
+	// Hook up (and drop) the bottom offset cache's invalidation on property edits and reimports
+	void Register();
+	void Unregister();
+
+	// Trace params that ignore the actor and everything attached to it
+	FCollisionQueryParams MakeTraceParams(AActor* Actor);
+
+	// Trace starts for the N x N footprint grid under the actor's bounds
+	// (LevelEditorShortcuts.SnapFootprintSamples; a single ray at the pivot when 1)
+	void GetFootprintStarts(const AActor* Actor, TArray<FVector, TInlineAllocator<16>>& OutStarts);
+
+	// Resting plane from the footprint's ground hits: least-squares slope, raised onto the highest
+	// sample. OutHit gets the plane point under the actor's pivot and the plane normal.
+	bool FitGroundPlane(const AActor* Actor, TConstArrayView<FHitResult> Hits, FHitResult& OutHit);
+
+	// One multi-hit query straight down from TraceStart, filtered with FindGroundHit
+	bool TraceGroundAt(UWorld* World, const FVector& TraceStart, const FCollisionQueryParams& QueryParams, FHitResult& OutHit, const FActorSet* PendingActors = nullptr);
+
+	// Hit result for ground found without a physics query (cached or heightfield samples)
+	FHitResult MakeGroundHit(const FVector& TraceStart, double Height, const FVector& Normal);
+
+	// Ground answers tried before a physics query for a footprint sample. Both ignore the whole
+	// selection, so they only stand in for traces of the bottom support layer.
+	struct FGroundSources
+	{
+		FGroundSources();
+		~FGroundSources();
+
+		FGroundHeightCache* HeightCache = nullptr;
+		TUniquePtr<FLandscapeGroundSampler> Landscape;
+
+		bool Sample(const FVector& TraceStart, FHitResult& OutHit) const;
+	};
+
+	// Set up the height cache and landscape fast path for snapping Actors, where they apply
+	// (footprint trace mode, selection large enough, cache enabled / landscape under the selection)
+	void PrepareGroundSources(UWorld* World, TConstArrayView<AActor*> Actors, FGroundSources& OutSources);
+
+	// Synchronous footprint trace: ground source or TraceGroundAt per sample, then FitGroundPlane
+	bool TraceGround(UWorld* World, AActor* Actor, FHitResult& OutHit, const FActorSet* PendingActors = nullptr, const FGroundSources* Sources = nullptr);
+
+	// Keep the actor's facing but tilt it so its up axis matches the surface normal
+	FRotator AlignToSurface(const FRotator& CurrentRotation, const FVector& SurfaceNormal);
+
+	// One collision piece swept by the shape snap mode, posed for the actor's final rotation
+	struct FSweepShape
+	{
+		FCollisionShape Shape;
+		FQuat Rotation = FQuat::Identity;
+
+		// Shape center relative to the actor's pivot
+		FVector Offset = FVector::ZeroVector;
+	};
+
+	// LevelEditorShortcuts.SnapSweepShapes
+	bool UseSweep();
+
+	// Simple collision of the actor's blocking components (boxes, spheres, capsules; convex hulls as oriented boxes)
+	void GetSweepShapes(AActor* Actor, const FQuat& FinalRotation, TArray<FSweepShape, TInlineAllocator<8>>& OutShapes);
+
+	// One multi-hit sweep of a shape straight down from SweepStart, filtered with FindGroundHit
+	bool SweepGroundAt(UWorld* World, const FVector& SweepStart, const FSweepShape& Shape, const FCollisionQueryParams& QueryParams, FHitResult& OutHit, const FActorSet* PendingActors = nullptr);
+
+	// Synchronous shape sweep: how far the actor drops from TraceStartHeight above its pivot until first contact
+	bool SweepGround(UWorld* World, AActor* Actor, const FQuat& FinalRotation, double& OutDropDistance, const FActorSet* PendingActors = nullptr);
+
+	// Synchronous snap of one actor in the current mode (footprint traces or shape sweep)
+	bool SnapActor(UWorld* World, AActor* Actor, bool bAlignToSurface, const FActorSet* PendingActors = nullptr, const FGroundSources* Sources = nullptr);
+
+	// Support order for a selection that rests on itself: an actor whose XY footprint overlaps a lower
+	// actor's goes in a later layer. OutLayers[i] is the layer of Actors[i]; returns the number of layers.
+	int32 BuildSupportLayers(TConstArrayView<AActor*> Actors, TArray<int32>& OutLayers);
+
+	// Actor origin height that rests the actor, in Rotation, on the hit surface (bottom offset plus clearance)
+	double CalcRestingHeight(AActor* Actor, const FQuat& Rotation, const FHitResult& Hit);
+
+	// Where the actor ends up on the hit surface. Without surface alignment the rotation is reset to world up.
+	void CalcSnapTransform(AActor* Actor, const FHitResult& Hit, bool bAlignToSurface, FVector& OutLocation, FRotator& OutRotation);
+
+	// Move the actor onto the hit surface (caller owns the transaction)
+	void ApplySnap(AActor* Actor, const FHitResult& Hit, bool bAlignToSurface);
+
+	void ApplySnapTransform(AActor* Actor, const FVector& NewLocation, const FRotator& NewRotation);
+}
+
+// Snaps a large selection over several frames: footprint traces (and shape sweeps in sweep mode)
+// are submitted in chunks through the world's async trace queue and collected as they complete,
+// one support layer at a time. Layers that others rest on are moved as soon as they resolve so the
+// next layer traces against them; that move is put back and everything is applied in a single
+// transaction on the final frame, so no transaction stays open while the batch runs.
+// Shows a progress notification with a cancel button for very large batches.
+class FGroundSnapBatch : public TSharedFromThis<FGroundSnapBatch>
+{
+public:
+	~FGroundSnapBatch();
+
+	// Capture every actor's trace request. Returns false if there is nothing to snap.
+	bool Start(UWorld* InWorld, TConstArrayView<AActor*> Actors, bool bInAlignToSurface, const FText& InTransactionText);
+
+	// Submit the next chunk of traces and apply everything once all results are in.
+	// Returns false once the batch has finished or was cancelled.
+	bool Tick();
+
+	// Drop all results without touching the actors
+	void Cancel();
+
+private:
+	struct FRequest
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FCollisionQueryParams Params;
+		TArray<FHitResult, TInlineAllocator<9>> GroundHits;
+		int32 NumSamplesPending = 0;
+
+		// Shape sweep mode
+		FVector SweepPivot = FVector::ZeroVector;
+		double DropDistance = 0.0;
+		bool bHasDrop = false;
+
+		// Resolved snap (also the sweep orientation)
+		FVector FinalLocation = FVector::ZeroVector;
+		FRotator FinalRotation = FRotator::ZeroRotator;
+		bool bResolved = false;
+
+		// Moved ahead of the transaction for the layers above; StartTransform is where it was
+		FTransform StartTransform;
+		bool bMovedEarly = false;
+	};
+
+	// One footprint ray or shape sweep; the async trace's user data is its index
+	struct FSample
+	{
+		int32 RequestIndex = INDEX_NONE;
+		FVector TraceStart = FVector::ZeroVector;
+		bool bSweep = false;
+		GroundSnap::FSweepShape Shape;
+	};
+
+	void AddSample(FSample&& Sample);
+
+	// Queue the request's shape sweeps in its FinalRotation. Returns false if there is nothing to sweep.
+	bool QueueSweeps(int32 RequestIndex);
+
+	void QueueLayer();
+
+	// The request's last outstanding sample is back. Returns true if it queued more work (sweeps).
+	bool ContinueRequest(int32 RequestIndex, bool bSweepPhase);
+
+	void SubmitPending();
+	void OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	// Work out CurrentLayer's transforms, moving the actors right away if a layer above rests on them
+	void ResolveLayer();
+
+	// Put early-moved actors back where they started; ones moved again since are left alone and
+	// dropped from the batch. Returns the number restored.
+	int32 RestoreMovedActors();
+
+	void Finish();
+	void UpdateProgress();
+	void CloseNotification(bool bSuccess, int32 NumSnapped = 0);
+
+	TWeakObjectPtr<UWorld> World;
+	TArray<FRequest> Requests;
+	TArray<FSample> Samples;
+
+	// Sample indices waiting to be traced
+	TArray<int32> PendingSubmit;
+	int32 NumInFlight = 0;
+	int32 NumFinished = 0;
+
+	// Request indices per support layer, bottom-up; only CurrentLayer is in flight
+	TArray<TArray<int32>> LayerRequests;
+	int32 CurrentLayer = 0;
+	int32 NumLayerPending = 0;
+
+	// Selected actors not snapped yet; hits on them are ignored
+	GroundSnap::FActorSet PendingActors;
+
+	// Cache / heightfield answers for the bottom layer
+	GroundSnap::FGroundSources Sources;
+
+	bool bAlignToSurface = false;
+	bool bSweep = false;
+	bool bCancelled = false;
+	FText TransactionText;
+	FTraceDelegate TraceDelegate;
+	TSharedPtr<SNotificationItem> Notification;
+};
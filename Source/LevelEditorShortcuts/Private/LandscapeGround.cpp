@@ -0,0 +1,289 @@
+// LandscapeGround.cpp
+// Landscape heightfield fast path for ground snap, plus LevelEditorShortcuts.BenchmarkLandscapeSnap
+// to compare it against the physics trace it replaces.
+
+#include "LandscapeGround.h"
+#include "GroundSnap.h"
+#include "LevelEditorShortcutsLog.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Components/PrimitiveComponent.h"
+#include "WorldCollision.h"
+#include "LandscapeProxy.h"
+#include "LandscapeComponent.h"
+#include "LandscapeHeightfieldCollisionComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+// XY bucket size for occluder bounds, and the most buckets one occluder may fill before it is
+// checked against every sample instead
+static constexpr double OccluderCellSize = 1000.0;
+static constexpr int64 MaxOccluderCells = 256;
+
+static FIntPoint ToOccluderCell(double X, double Y)
+{
+	return FIntPoint(FMath::FloorToInt32(X / OccluderCellSize), FMath::FloorToInt32(Y / OccluderCellSize));
+}
+
+static bool OverlapsXY(const FBox& A, const FBox& B)
+{
+	return A.Min.X <= B.Max.X && B.Min.X <= A.Max.X && A.Min.Y <= B.Max.Y && B.Min.Y <= A.Max.Y;
+}
+
+void FLandscapeGroundSampler::Build(UWorld* World, const FBox& Region, TConstArrayView<AActor*> ExcludedActors)
+{
+	Landscapes.Reset();
+	Occluders.Reset();
+	OccluderGrid.Reset();
+	LargeOccluders.Reset();
+
+	if (!World || !Region.IsValid)
+	{
+		return;
+	}
+
+	for (TActorIterator<ALandscapeProxy> It(World); It; ++It)
+	{
+		ALandscapeProxy* Proxy = *It;
+		const FBox Bounds = Proxy->GetComponentsBoundingBox(true);
+		if (!Bounds.IsValid || !OverlapsXY(Bounds, Region))
+		{
+			continue;
+		}
+
+		// Landscapes that the snap traces would pass through aren't ground either
+		const ULandscapeHeightfieldCollisionComponent* Collision = Proxy->CollisionComponents.Num() > 0 ? Proxy->CollisionComponents[0].Get() : nullptr;
+		if (!GroundSnap::BlocksGroundTrace(Collision))
+		{
+			continue;
+		}
+
+		Landscapes.Add({ Proxy, Bounds, FMath::Abs(Proxy->GetActorScale3D().X) });
+	}
+
+	if (Landscapes.Num() == 0)
+	{
+		return;
+	}
+
+	TSet<const AActor*> Excluded;
+	for (AActor* Actor : ExcludedActors)
+	{
+		Excluded.Add(Actor);
+		TArray<AActor*> AttachedActors;
+		Actor->GetAttachedActors(AttachedActors, true, true);
+		Excluded.Append(AttachedActors);
+	}
+
+	// Everything else a ground trace could stop on - including landscape spline meshes. One overlap
+	// query over the region, from the lowest landscape up to where the traces start; geometry wholly
+	// below the landscapes can't stand above their surface.
+	double MinZ = Landscapes[0].Bounds.Min.Z;
+	for (const FLandscapeEntry& Entry : Landscapes)
+	{
+		MinZ = FMath::Min(MinZ, Entry.Bounds.Min.Z);
+	}
+	const FBox QueryBox(FVector(Region.Min.X, Region.Min.Y, MinZ - 1.0), FVector(Region.Max.X, Region.Max.Y, Region.Max.Z + GroundSnap::TraceStartHeight));
+
+	TArray<FOverlapResult> Overlaps;
+	World->OverlapMultiByObjectType(Overlaps, QueryBox.GetCenter(), FQuat::Identity, GroundSnap::GetGroundObjectParams(),
+		FCollisionShape::MakeBox(QueryBox.GetExtent()), FCollisionQueryParams(SCENE_QUERY_STAT(LevelEditorShortcutsLandscapeOccluders)));
+
+	// Instanced components report one overlap per instance
+	TSet<const UPrimitiveComponent*> SeenComps;
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		const UPrimitiveComponent* Comp = Overlap.GetComponent();
+		if (!Comp || Excluded.Contains(Comp->GetOwner()))
+		{
+			continue;
+		}
+
+		bool bAlreadySeen = false;
+		SeenComps.Add(Comp, &bAlreadySeen);
+		if (bAlreadySeen || Comp->IsA<ULandscapeHeightfieldCollisionComponent>() || Comp->IsA<ULandscapeComponent>() || !GroundSnap::BlocksGroundTrace(Comp))
+		{
+			continue;
+		}
+
+		const FBox Bounds = Comp->Bounds.GetBox();
+		const int32 Index = Occluders.Add(Bounds);
+		const FIntPoint MinCell = ToOccluderCell(Bounds.Min.X, Bounds.Min.Y);
+		const FIntPoint MaxCell = ToOccluderCell(Bounds.Max.X, Bounds.Max.Y);
+		if (int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) > MaxOccluderCells)
+		{
+			LargeOccluders.Add(Index);
+			continue;
+		}
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+			{
+				OccluderGrid.FindOrAdd(FIntPoint(X, Y)).Add(Index);
+			}
+		}
+	}
+}
+
+bool FLandscapeGroundSampler::GetHeight(double X, double Y, double& OutHeight, double* OutQuadSize) const
+{
+	bool bFound = false;
+	for (const FLandscapeEntry& Entry : Landscapes)
+	{
+		if (X < Entry.Bounds.Min.X || X > Entry.Bounds.Max.X || Y < Entry.Bounds.Min.Y || Y > Entry.Bounds.Max.Y)
+		{
+			continue;
+		}
+
+		const ALandscapeProxy* Proxy = Entry.Proxy.Get();
+		if (!Proxy)
+		{
+			continue;
+		}
+
+		// Simple collision is what non-complex traces hit; older/unbuilt data may only have complex
+		const FVector Location(X, Y, 0.0);
+		TOptional<float> Height = Proxy->GetHeightAtLocation(Location, EHeightfieldSource::Simple);
+		if (!Height.IsSet())
+		{
+			Height = Proxy->GetHeightAtLocation(Location, EHeightfieldSource::Complex);
+		}
+		if (Height.IsSet() && (!bFound || Height.GetValue() > OutHeight))
+		{
+			OutHeight = Height.GetValue();
+			if (OutQuadSize)
+			{
+				*OutQuadSize = Entry.QuadSize;
+			}
+			bFound = true;
+		}
+	}
+	return bFound;
+}
+
+bool FLandscapeGroundSampler::Sample(const FVector& TraceStart, FHitResult& OutHit) const
+{
+	double Height = 0.0;
+	double Step = 100.0;
+	if (!GetHeight(TraceStart.X, TraceStart.Y, Height, &Step) || Height > TraceStart.Z)
+	{
+		return false;
+	}
+
+	// Anything reaching above the surface in this column would be hit first
+	auto BlocksColumn = [&TraceStart, Height](const FBox& Bounds)
+	{
+		return TraceStart.X >= Bounds.Min.X && TraceStart.X <= Bounds.Max.X
+			&& TraceStart.Y >= Bounds.Min.Y && TraceStart.Y <= Bounds.Max.Y
+			&& Bounds.Max.Z >= Height - 1.0 && Bounds.Min.Z <= TraceStart.Z;
+	};
+	for (int32 Index : LargeOccluders)
+	{
+		if (BlocksColumn(Occluders[Index]))
+		{
+			return false;
+		}
+	}
+	if (const TArray<int32>* Cell = OccluderGrid.Find(ToOccluderCell(TraceStart.X, TraceStart.Y)))
+	{
+		for (int32 Index : *Cell)
+		{
+			if (BlocksColumn(Occluders[Index]))
+			{
+				return false;
+			}
+		}
+	}
+
+	// Normal from central differences one quad apart, on the landscape that supplied the height
+	double HeightX0 = Height, HeightX1 = Height, HeightY0 = Height, HeightY1 = Height;
+	GetHeight(TraceStart.X - Step, TraceStart.Y, HeightX0);
+	GetHeight(TraceStart.X + Step, TraceStart.Y, HeightX1);
+	GetHeight(TraceStart.X, TraceStart.Y - Step, HeightY0);
+	GetHeight(TraceStart.X, TraceStart.Y + Step, HeightY1);
+	const FVector Normal = FVector((HeightX0 - HeightX1) / (2.0 * Step), (HeightY0 - HeightY1) / (2.0 * Step), 1.0).GetSafeNormal();
+
+	OutHit = GroundSnap::MakeGroundHit(TraceStart, Height, Normal);
+	return true;
+}
+
+// LevelEditorShortcuts.BenchmarkLandscapeSnap [NumSamples] - heightfield fast path vs physics ground
+// traces for random columns over the landscapes in the current level (default 50000)
+static void RunLandscapeSnapBenchmark(const TArray<FString>& Args)
+{
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+
+	const int32 NumSamples = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 50000;
+
+	FBox LandscapeBounds(ForceInit);
+	for (TActorIterator<ALandscapeProxy> It(World); It; ++It)
+	{
+		LandscapeBounds += It->GetComponentsBoundingBox(true);
+	}
+	if (!LandscapeBounds.IsValid)
+	{
+		UE_LOG(LogLevelEditorShortcuts, Warning, TEXT("BenchmarkLandscapeSnap: no landscape in the current level"));
+		return;
+	}
+
+	FRandomStream Random(1234);
+	TArray<FVector> Starts;
+	Starts.SetNumUninitialized(NumSamples);
+	for (FVector& Start : Starts)
+	{
+		Start = FVector(Random.FRandRange(LandscapeBounds.Min.X, LandscapeBounds.Max.X),
+			Random.FRandRange(LandscapeBounds.Min.Y, LandscapeBounds.Max.Y), LandscapeBounds.Max.Z + GroundSnap::TraceStartHeight);
+	}
+
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(LevelEditorShortcutsGroundSnap));
+	double StartTime = FPlatformTime::Seconds();
+	TArray<FHitResult> TraceHits;
+	TArray<bool> bTraceHit;
+	TraceHits.SetNum(NumSamples);
+	bTraceHit.SetNum(NumSamples);
+	for (int32 i = 0; i < NumSamples; i++)
+	{
+		bTraceHit[i] = GroundSnap::TraceGroundAt(World, Starts[i], QueryParams, TraceHits[i]);
+	}
+	const double TraceMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	StartTime = FPlatformTime::Seconds();
+	FLandscapeGroundSampler Sampler;
+	Sampler.Build(World, LandscapeBounds, TArrayView<AActor*>());
+	const double BuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	StartTime = FPlatformTime::Seconds();
+	int32 NumFastPath = 0;
+	int32 NumMismatches = 0;
+	for (int32 i = 0; i < NumSamples; i++)
+	{
+		FHitResult Hit;
+		if (Sampler.Sample(Starts[i], Hit))
+		{
+			NumFastPath++;
+			if (!bTraceHit[i] || !FMath::IsNearlyEqual(Hit.ImpactPoint.Z, TraceHits[i].ImpactPoint.Z, 1.0))
+			{
+				NumMismatches++;
+			}
+		}
+		else
+		{
+			GroundSnap::TraceGroundAt(World, Starts[i], QueryParams, Hit);
+		}
+	}
+	const double FastMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	UE_LOG(LogLevelEditorShortcuts, Display, TEXT("Landscape snap: %d columns, physics traces %.2f ms -> heightfield %.2f ms + %.2f ms setup (%d from heightfield, %d traced, %d differ by > 1 cm)"),
+		NumSamples, TraceMs, FastMs, BuildMs, NumFastPath, NumSamples - NumFastPath, NumMismatches);
+}
+
+static FAutoConsoleCommand BenchmarkLandscapeSnapCommand(
+	TEXT("LevelEditorShortcuts.BenchmarkLandscapeSnap"),
+	TEXT("Compares the landscape heightfield ground snap fast path against physics traces for random columns over the level's landscapes. Optional argument: number of columns (default 50000)."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunLandscapeSnapBenchmark));
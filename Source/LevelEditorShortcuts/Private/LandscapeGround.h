@@ -0,0 +1,46 @@
+// LandscapeGround.h
+// Landscape heightfield fast path for ground snap: reads height and normal straight from the
+// landscape under a trace column instead of running a physics query, as long as no other
+// blocking geometry stands in that column above the landscape surface.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/HitResult.h"
+
+class AActor;
+class ALandscapeProxy;
+class UWorld;
+
+class FLandscapeGroundSampler
+{
+public:
+	// Collect the landscapes and every other ground-blocking primitive over Region (XY only).
+	// ExcludedActors (the selection being snapped) and anything attached to them are skipped,
+	// since the snap traces ignore or skip them too.
+	void Build(UWorld* World, const FBox& Region, TConstArrayView<AActor*> ExcludedActors);
+
+	bool HasLandscape() const { return Landscapes.Num() > 0; }
+
+	// Ground hit straight below TraceStart when that column holds only landscape.
+	// Returns false when a physics trace has to decide (other geometry in the column, or no landscape).
+	bool Sample(const FVector& TraceStart, FHitResult& OutHit) const;
+
+private:
+	// Highest landscape surface at X, Y; OutQuadSize is the quad size of the landscape it came from
+	bool GetHeight(double X, double Y, double& OutHeight, double* OutQuadSize = nullptr) const;
+
+	struct FLandscapeEntry
+	{
+		TWeakObjectPtr<ALandscapeProxy> Proxy;
+		FBox Bounds;
+		double QuadSize = 100.0;
+	};
+
+	TArray<FLandscapeEntry> Landscapes;
+
+	// Bounds of non-landscape ground geometry, bucketed in an XY grid
+	TArray<FBox> Occluders;
+	TMap<FIntPoint, TArray<int32>> OccluderGrid;
+	TArray<int32> LargeOccluders;
+};
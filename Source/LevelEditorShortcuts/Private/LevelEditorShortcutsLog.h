@@ -0,0 +1,11 @@
+// LevelEditorShortcutsLog.h
+// Log category and stat group shared by every file in the module.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogLevelEditorShortcuts, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("LevelEditorShortcuts"), STATGROUP_LevelEditorShortcuts, STATCAT_Advanced);
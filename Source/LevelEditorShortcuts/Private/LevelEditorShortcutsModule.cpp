@@ -1,9 +1,14 @@
 #include "LevelEditorShortcutsModule.h"
 #include "Framework/Application/SlateApplication.h"
+#include "LevelEditorShortcutsLog.h"
+
+DEFINE_LOG_CATEGORY(LogLevelEditorShortcuts);
 
 // Forward declarations of registration functions
 namespace TransformCopyPaste { void Register(); void Unregister(); }
 namespace LevelEditorShortcuts { void Register(); void Unregister(); }
+namespace GroundHeightCache { void Register(); void Unregister(); }
+namespace GroundSnap { void Register(); void Unregister(); }
 
 #define LOCTEXT_NAMESPACE "FLevelEditorShortcutsModule"
 
@@ -15,6 +20,9 @@ void FLevelEditorShortcutsModule::StartupModule()
 		TransformCopyPaste::Register();
 		LevelEditorShortcuts::Register();
 	}
+
+	GroundHeightCache::Register();
+	GroundSnap::Register();
 }
 
 void FLevelEditorShortcutsModule::ShutdownModule()
@@ -22,6 +30,8 @@ void FLevelEditorShortcutsModule::ShutdownModule()
 	// Unregister input processors
 	TransformCopyPaste::Unregister();
 	LevelEditorShortcuts::Unregister();
+	GroundHeightCache::Unregister();
+	GroundSnap::Unregister();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -2,6 +2,7 @@
 // Editor-only input processor for level editor shortcuts:
 // 1-2-3: Widget modes (Move, Rotate, Scale) - disabled in Landscape/Foliage modes
 // Q+Drag: Move selected actor(s) horizontally (respects local/world space)
+// Alt+Q+Drag: Move horizontally while keeping each actor resting on the ground below it
 // E+Drag: Move selected actor(s) vertically (respects local/world space)
 // R+Drag: Scale selected actor(s) uniformly (outward=up, inward=down)
 // Q+Scroll: Rotate selected actor(s) around Z axis
@@ -14,6 +15,7 @@
 #include "Editor.h"
 #include "Engine/Selection.h"
 #include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
 #include "ScopedTransaction.h"
 #include "EditorModeManager.h"
 #include "EditorModes.h"
@@ -24,13 +26,356 @@
 #include "LevelEditorViewport.h"
 #include "UnrealWidget.h"
 #include "SceneView.h"
+#include "Slate/SceneViewport.h"
 #include "Editor/GroupActor.h"
+#include "TransformKernels.h"
+#include "GroundSnap.h"
+#include "GroundHeightCache.h"
+#include "LevelEditorShortcutsLog.h"
+#include "Components/LineBatchComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Stats/Stats.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Drag Frames"), STAT_LevelEditorShortcuts_DragFrames, STATGROUP_LevelEditorShortcuts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Selection Broadcasts"), STAT_LevelEditorShortcuts_SelectionBroadcasts, STATGROUP_LevelEditorShortcuts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Drag Actors Applied"), STAT_LevelEditorShortcuts_DragActorsApplied, STATGROUP_LevelEditorShortcuts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Drag Actors Pending"), STAT_LevelEditorShortcuts_DragActorsPending, STATGROUP_LevelEditorShortcuts);
+
+static TAutoConsoleVariable<int32> CVarDeferSelectionNotify(
+	TEXT("LevelEditorShortcuts.DeferSelectionNotify"),
+	1,
+	TEXT("1: Q/E/R drags only move the gizmo pivot per frame and broadcast one selection change on key-up.\n")
+	TEXT("0: Broadcast a full selection change (details panel rebuild) every drag frame."));
+
+static TAutoConsoleVariable<int32> CVarPreviewDragTransforms(
+	TEXT("LevelEditorShortcuts.PreviewDragTransforms"),
+	1,
+	TEXT("1: Q/E/R drags only update component (render) transforms per frame; physics, overlaps and PostEditMove are applied once on key-up.\n")
+	TEXT("0: Fully move every actor (physics, overlaps, PostEditMove) every drag frame."));
+
+static TAutoConsoleVariable<int32> CVarProxyDragThreshold(
+	TEXT("LevelEditorShortcuts.ProxyDragThreshold"),
+	5000,
+	TEXT("Selections with at least this many actors drag a bounding-box proxy and apply the real transforms on key-up. 0 disables."));
+
+static TAutoConsoleVariable<int32> CVarProxyDragMaxBoxes(
+	TEXT("LevelEditorShortcuts.ProxyDragMaxBoxes"),
+	5000,
+	TEXT("Maximum number of per-actor boxes drawn by the drag proxy. Larger selections only draw the combined bounds."));
+
+static TAutoConsoleVariable<float> CVarDragApplyBudgetMs(
+	TEXT("LevelEditorShortcuts.DragApplyBudgetMs"),
+	4.0f,
+	TEXT("Per-frame time budget (ms) for applying Q/E/R drag transforms. Actors that don't fit are updated on the following frames. 0 = unlimited."));
+
+static TAutoConsoleVariable<int32> CVarParallelTransformThreshold(
+	TEXT("LevelEditorShortcuts.ParallelTransformThreshold"),
+	4096,
+	TEXT("Minimum number of actors before per-actor transform math (move/scale/rotate targets) runs on worker threads with ParallelFor."));
+
+static TAutoConsoleVariable<int32> CVarCursorLockedDrag(
+	TEXT("LevelEditorShortcuts.CursorLockedDrag"),
+	1,
+	TEXT("1: Q+Drag intersects the cursor ray with the movement plane so actors stay exactly under the cursor (perspective and ortho).\n")
+	TEXT("0: Use the camera-distance/FOV approximation."));
+
+static TAutoConsoleVariable<int32> CVarRawMouseDrag(
+	TEXT("LevelEditorShortcuts.RawMouseDrag"),
+	1,
+	TEXT("1: Q/E/R drags capture the hidden cursor and read its motion from mouse events. E/R drags use raw relative input\n")
+	TEXT("   (high precision mouse mode); cursor-locked Q drags (CursorLockedDrag=1) follow screen pixels and only warp\n")
+	TEXT("   the cursor back when it nears the viewport edge.\n")
+	TEXT("0: Poll the cursor position and warp it back to the drag start every frame."));
+
+static TAutoConsoleVariable<float> CVarSurfaceDragCellSize(
+	TEXT("LevelEditorShortcuts.SurfaceDragCellSize"),
+	10.0f,
+	TEXT("Alt+Q+Drag only re-queries the ground for an actor once it crosses into another cell of this size (world units)."));
+
+static TAutoConsoleVariable<int32> CVarSurfaceDragTracesPerFrame(
+	TEXT("LevelEditorShortcuts.SurfaceDragTracesPerFrame"),
+	256,
+	TEXT("Maximum physics ground traces per frame for Alt+Q+Drag when the height cache can't answer. Remaining actors keep their height until a later frame."));
+
+static TAutoConsoleVariable<int32> CVarSurfaceDragTilesPerFrame(
+	TEXT("LevelEditorShortcuts.SurfaceDragTilesPerFrame"),
+	4,
+	TEXT("Maximum ground height cache tiles queued per frame ahead of an Alt+Q+Drag."));
+
+// A pixel-captured drag cursor is warped back once it is within this fraction of the viewport size of an edge
+static constexpr float CapturedCursorEdgeMargin = 0.1f;
+
+// Run Body over [0, Num) in fixed-size batches, on worker threads once Num reaches ParallelThreshold.
+// Only for pure math on plain arrays - UObjects must still be touched on the game thread.
+static void ParallelForActorRange(int32 Num, int32 ParallelThreshold, TFunctionRef<void(int32 Begin, int32 End)> Body)
+{
+	constexpr int32 BatchSize = 1024;
+	const int32 NumBatches = FMath::DivideAndRoundUp(Num, BatchSize);
+	const EParallelForFlags Flags = Num >= ParallelThreshold ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+
+	ParallelFor(NumBatches, [Num, &Body](int32 Batch)
+	{
+		const int32 Begin = Batch * BatchSize;
+		Body(Begin, FMath::Min(Begin + BatchSize, Num));
+	}, Flags);
+}
+
+// Snapshot of the selection taken on the first frame of a Q/E/R drag.
+// Actors are resolved once and their start transforms kept in parallel arrays,
+// so per-frame updates walk contiguous memory instead of USelection.
+// Only the selection-changed delegate invalidates it mid-drag; actors are held weakly since
+// a GC can run between the selection change and the next drag frame.
+struct FShortcutDragSession
+{
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	TArray<FVector> StartLocations;
+	TArray<FQuat> StartRotations;
+	TArray<FVector> StartScales;
+
+	// Center of StartLocations, computed once per capture. Translation moves it by AppliedOffset
+	// and rotation about it leaves it in place, so GetPivot() never has to walk the actors.
+	FVector StartPivot = FVector::ZeroVector;
+
+	// Translation applied on top of StartLocations so far this drag
+	FVector AppliedOffset = FVector::ZeroVector;
+
+	// Uniform scale multiplier applied on top of StartScales so far this drag
+	float AppliedScale = 1.0f;
+
+	// Per-actor targets for the current AppliedOffset/AppliedScale, filled by UpdateTargets
+	TArray<FVector> TargetLocations;
+	TArray<FVector> TargetScales;
+
+	// Bounding-proxy mode: per-actor world bounds in drag-start space, only captured for proxy drags
+	TArray<FBox> StartBounds;
+	FBox StartCombinedBounds = FBox(ForceInit);
+	bool bProxyMode = false;
+
+	// Q+scroll rotation about StartPivot since the bounds were captured (proxy mode defers it to key-up)
+	FQuat ProxyRotation = FQuat::Identity;
+
+	// Proxy moved but the real actors have not been updated yet
+	bool bProxyPending = false;
+
+	// Alt was held on the last proxy drag frame: the flush lands the actors on the ground
+	bool bProxyGroundFollow = false;
+
+	// Time-sliced apply: next actor to update and how many still lag behind the current drag state
+	int32 ApplyCursor = 0;
+	int32 NumPendingApply = 0;
+
+	// True if any selected actor belongs to a group (rotation uses the shared center)
+	bool bHasGroup = false;
+	bool bValid = false;
+
+	// Preview transforms were applied and physics/overlaps/PostEditMove still need a commit
+	bool bPreviewPending = false;
+
+	// Alt+Q+Drag: resting height per actor and the cell it was resolved in; actors still
+	// waiting for a ground query (over budget) keep their last height
+	TArray<double> GroundHeights;
+	TArray<FIntPoint> GroundCells;
+	int32 NumGroundPending = 0;
+	bool bGroundFollow = false;
+
+	int32 Num() const { return Actors.Num(); }
+
+	void Capture(USelection* Selection)
+	{
+		Reset();
+		if (!Selection)
+		{
+			return;
+		}
+
+		const int32 NumSelected = Selection->Num();
+		Actors.Reserve(NumSelected);
+		StartLocations.Reserve(NumSelected);
+		StartRotations.Reserve(NumSelected);
+		StartScales.Reserve(NumSelected);
+
+		for (int32 i = 0; i < NumSelected; i++)
+		{
+			AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i));
+			if (!Actor)
+			{
+				continue;
+			}
+
+			// Record undo state once per drag - the drag transaction is already open
+			Actor->Modify();
+
+			const FTransform& Transform = Actor->GetActorTransform();
+			Actors.Add(Actor);
+			StartLocations.Add(Transform.GetLocation());
+			StartRotations.Add(Transform.GetRotation());
+			StartScales.Add(Transform.GetScale3D());
+
+			// GetRootForActor is exported, GetParentForActor is not
+			if (!bHasGroup && AGroupActor::GetRootForActor(Actor))
+			{
+				bHasGroup = true;
+			}
+
+			StartPivot += Transform.GetLocation();
+		}
+
+		bValid = Actors.Num() > 0;
+		if (bValid)
+		{
+			StartPivot /= Actors.Num();
+		}
+	}
+
+	void Reset()
+	{
+		Actors.Reset();
+		StartLocations.Reset();
+		StartRotations.Reset();
+		StartScales.Reset();
+		TargetLocations.Reset();
+		TargetScales.Reset();
+		StartBounds.Reset();
+		StartCombinedBounds = FBox(ForceInit);
+		ProxyRotation = FQuat::Identity;
+		StartPivot = FVector::ZeroVector;
+		AppliedOffset = FVector::ZeroVector;
+		AppliedScale = 1.0f;
+		bHasGroup = false;
+		bValid = false;
+		bPreviewPending = false;
+		bProxyMode = false;
+		bProxyPending = false;
+		bProxyGroundFollow = false;
+		ApplyCursor = 0;
+		NumPendingApply = 0;
+		GroundHeights.Reset();
+		GroundCells.Reset();
+		NumGroundPending = 0;
+		bGroundFollow = false;
+	}
+
+	FVector GetLocation(int32 Index) const
+	{
+		return StartLocations[Index] + AppliedOffset;
+	}
+
+	// Compute every actor's target location/scale for the current drag state
+	void UpdateTargets(int32 ParallelThreshold)
+	{
+		const int32 NumActors = StartLocations.Num();
+		TargetLocations.SetNumUninitialized(NumActors);
+		TargetScales.SetNumUninitialized(NumActors);
+
+		ParallelForActorRange(NumActors, ParallelThreshold, [this](int32 Begin, int32 End)
+		{
+			const int32 Count = End - Begin;
+			TransformKernels::Translate(MakeArrayView(StartLocations).Slice(Begin, Count), AppliedOffset, MakeArrayView(TargetLocations).Slice(Begin, Count));
+			TransformKernels::ScaleClamped(MakeArrayView(StartScales).Slice(Begin, Count), AppliedScale, 0.001, MakeArrayView(TargetScales).Slice(Begin, Count));
+		});
+	}
+
+	// Rotate the snapshot around world Z: each actor's own rotation, and optionally its
+	// location about StartPivot (which rotation about itself leaves unchanged)
+	void RotateAboutZ(const FQuat& Rotation, bool bAroundPivot, int32 ParallelThreshold)
+	{
+		ParallelForActorRange(StartLocations.Num(), ParallelThreshold, [this, &Rotation, bAroundPivot](int32 Begin, int32 End)
+		{
+			const int32 Count = End - Begin;
+			TArrayView<FVector> Locations = bAroundPivot ? MakeArrayView(StartLocations).Slice(Begin, Count) : TArrayView<FVector>();
+			TransformKernels::RotateAboutPivot(Locations, MakeArrayView(StartRotations).Slice(Begin, Count), StartPivot, Rotation);
+		});
+	}
+
+	// Capture component bounds for the proxy, relative to the current AppliedOffset
+	void CaptureBounds()
+	{
+		StartBounds.SetNumUninitialized(Actors.Num());
+		StartCombinedBounds = FBox(ForceInit);
+		ProxyRotation = FQuat::Identity;
+		for (int32 i = 0; i < Actors.Num(); i++)
+		{
+			const AActor* Actor = Actors[i].Get();
+			StartBounds[i] = Actor ? Actor->GetComponentsBoundingBox(true).ShiftBy(-AppliedOffset) : FBox(StartLocations[i], StartLocations[i]);
+			StartCombinedBounds += StartBounds[i];
+		}
+	}
+
+	// Current combined bounds - O(1) while only translating, O(N) once scale is involved
+	FBox GetCombinedBounds() const
+	{
+		if (AppliedScale == 1.0f)
+		{
+			return RotateProxyBox(StartCombinedBounds).ShiftBy(AppliedOffset);
+		}
+
+		FBox Combined(ForceInit);
+		for (int32 i = 0; i < StartBounds.Num(); i++)
+		{
+			Combined += GetProxyBounds(i);
+		}
+		return Combined;
+	}
+
+	// Current proxy box for one actor (scaled about its pivot, then offset)
+	FBox GetProxyBounds(int32 Index) const
+	{
+		FBox Box = RotateProxyBox(StartBounds[Index]);
+		if (AppliedScale != 1.0f)
+		{
+			const FVector& Pivot = StartLocations[Index];
+			Box = FBox(Pivot + (Box.Min - Pivot) * AppliedScale, Pivot + (Box.Max - Pivot) * AppliedScale);
+		}
+		return Box.ShiftBy(AppliedOffset);
+	}
+
+	// Box around a captured bounds box once ProxyRotation is applied about StartPivot. Always built
+	// from the captured box, so repeated rotations don't keep growing it.
+	FBox RotateProxyBox(const FBox& Box) const
+	{
+		if (ProxyRotation.Equals(FQuat::Identity))
+		{
+			return Box;
+		}
+
+		FBox Rotated(ForceInit);
+		for (int32 Corner = 0; Corner < 8; Corner++)
+		{
+			const FVector Point((Corner & 1) ? Box.Max.X : Box.Min.X, (Corner & 2) ? Box.Max.Y : Box.Min.Y, (Corner & 4) ? Box.Max.Z : Box.Min.Z);
+			Rotated += StartPivot + ProxyRotation.RotateVector(Point - StartPivot);
+		}
+		return Rotated;
+	}
+
+	// Center of the actors' current locations
+	FVector GetPivot() const
+	{
+		return StartPivot + AppliedOffset;
+	}
+};
 
 class FLevelEditorShortcutsProcessor : public IInputProcessor
 {
 public:
 	static TSharedPtr<FLevelEditorShortcutsProcessor> Instance;
 
+	FLevelEditorShortcutsProcessor()
+	{
+		// Any selection change mid-drag invalidates the cached snapshot
+		SelectionChangedHandle = USelection::SelectionChangedEvent.AddRaw(this, &FLevelEditorShortcutsProcessor::OnSelectionChanged);
+		SelectObjectHandle = USelection::SelectObjectEvent.AddRaw(this, &FLevelEditorShortcutsProcessor::OnSelectionChanged);
+	}
+
+	virtual ~FLevelEditorShortcutsProcessor()
+	{
+		EndRawMouseCapture();
+		USelection::SelectionChangedEvent.Remove(SelectionChangedHandle);
+		USelection::SelectObjectEvent.Remove(SelectObjectHandle);
+	}
+
 	static void Register()
 	{
 		if (!Instance.IsValid() && FSlateApplication::IsInitialized())
@@ -63,27 +408,51 @@ public:
 		// Q/E/R held = drag mode (no click required)
 		if (bQKeyDown || bEKeyDown || bRKeyDown)
 		{
-			FVector2D CurrentMousePosition = SlateApp.GetCursorPos();
-			FVector2D MouseDelta = CurrentMousePosition - LastMousePosition;
+			FVector2D MouseDelta = FVector2D::ZeroVector;
 
-			// When cursor is hidden, warp it back to start position for infinite movement range
-			if (bCursorHidden)
+			if (bRawMouseCaptured)
 			{
-				SlateApp.SetCursorPos(DragStartCursorPos);
-				LastMousePosition = DragStartCursorPos;
+				if (!bHighPrecisionMouse)
+				{
+					// Motion no event reported (e.g. past the window edge), then keep the cursor in the viewport
+					const FVector2D CurrentMousePosition = SlateApp.GetCursorPos();
+					PendingRawMouseDelta += CurrentMousePosition - LastMousePosition;
+					LastMousePosition = CurrentMousePosition;
+					WarpCapturedCursorFromViewportEdge(SlateApp);
+				}
+
+				// Relative motion accumulated by HandleMouseMoveEvent since the last tick
+				MouseDelta = PendingRawMouseDelta;
+				PendingRawMouseDelta = FVector2D::ZeroVector;
 			}
 			else
 			{
-				// Always update last position to avoid accumulating delta over frames
-				LastMousePosition = CurrentMousePosition;
+				FVector2D CurrentMousePosition = SlateApp.GetCursorPos();
+				MouseDelta = CurrentMousePosition - LastMousePosition;
+
+				// When cursor is hidden, warp it back to start position for infinite movement range
+				if (bCursorHidden)
+				{
+					SlateApp.SetCursorPos(DragStartCursorPos);
+					LastMousePosition = DragStartCursorPos;
+				}
+				else
+				{
+					// Always update last position to avoid accumulating delta over frames
+					LastMousePosition = CurrentMousePosition;
+				}
 			}
 
-			// Skip if no movement
+			// Skip if no movement (but keep working through a time-sliced update)
 			if (MouseDelta.IsNearlyZero())
 			{
+				TickPendingDragTransforms();
 				return;
 			}
 
+			// Where the cursor would be without warping/capture - drives cursor-locked dragging
+			DragVirtualCursorPos += MouseDelta;
+
 			if (bQKeyDown)
 			{
 				MoveSelectedActorsHorizontal(MouseDelta);
@@ -96,6 +465,8 @@ public:
 			{
 				ScaleSelectedActorsUniform(MouseDelta);
 			}
+
+			TickPendingDragTransforms();
 		}
 	}
 
@@ -130,7 +501,9 @@ public:
 				bQKeyDown = true;
 				LastMousePosition = SlateApp.GetCursorPos(); // Capture start position
 				DragStartCursorPos = LastMousePosition;
+				DragVirtualCursorPos = DragStartCursorPos;
 				SetCursorHidden(true);
+				DragViewportClient = GetActiveViewportClient(); // Viewport that owns this drag
 			}
 			if (!InKeyEvent.IsControlDown() && !InKeyEvent.IsAltDown() && !InKeyEvent.IsShiftDown())
 			{
@@ -152,7 +525,9 @@ public:
 				bEKeyDown = true;
 				LastMousePosition = SlateApp.GetCursorPos(); // Capture start position
 				DragStartCursorPos = LastMousePosition;
+				DragVirtualCursorPos = DragStartCursorPos;
 				SetCursorHidden(true);
+				DragViewportClient = GetActiveViewportClient(); // Viewport that owns this drag
 			}
 			if (!InKeyEvent.IsControlDown() && !InKeyEvent.IsAltDown() && !InKeyEvent.IsShiftDown())
 			{
@@ -182,7 +557,9 @@ public:
 				bRKeyDown = true;
 				LastMousePosition = SlateApp.GetCursorPos();
 				DragStartCursorPos = LastMousePosition;
+				DragVirtualCursorPos = DragStartCursorPos;
 				SetCursorHidden(true);
+				DragViewportClient = GetActiveViewportClient(); // Viewport that owns this drag
 			}
 			if (!InKeyEvent.IsControlDown() && !InKeyEvent.IsAltDown() && !InKeyEvent.IsShiftDown())
 			{
@@ -246,7 +623,7 @@ public:
 			// Update gizmo to new actor position
 			if (GEditor)
 			{
-				GEditor->NoteSelectionChange();
+				BroadcastSelectionChange();
 				GEditor->RedrawLevelEditingViewports();
 			}
 			return true;
@@ -259,7 +636,7 @@ public:
 			// Update gizmo to new actor position
 			if (GEditor)
 			{
-				GEditor->NoteSelectionChange();
+				BroadcastSelectionChange();
 				GEditor->RedrawLevelEditingViewports();
 			}
 			return true;
@@ -271,7 +648,7 @@ public:
 			SetCursorHidden(false);
 			if (GEditor)
 			{
-				GEditor->NoteSelectionChange();
+				BroadcastSelectionChange();
 				GEditor->RedrawLevelEditingViewports();
 			}
 			return true;
@@ -337,6 +714,21 @@ public:
 
 	virtual bool HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override
 	{
+		// During a captured Q/E/R drag, every motion event counts - Tick consumes the sum
+		if (bRawMouseCaptured && (bQKeyDown || bEKeyDown || bRKeyDown))
+		{
+			if (bHighPrecisionMouse)
+			{
+				PendingRawMouseDelta += MouseEvent.GetCursorDelta();
+			}
+			else
+			{
+				// Pixel motion since the last event or edge warp
+				PendingRawMouseDelta += MouseEvent.GetScreenSpacePosition() - LastMousePosition;
+				LastMousePosition = MouseEvent.GetScreenSpacePosition();
+			}
+			return true; // The viewport shouldn't also react to drag motion
+		}
 		return false;
 	}
 
@@ -375,64 +767,611 @@ public:
 			bGScrolledWhileDown = true; // Still mark as scrolled so we don't toggle on release
 		}
 
-		return false;
+		return false;
+	}
+
+private:
+	bool bQKeyDown = false;
+	bool bQScrolledWhileDown = false;
+	bool bEKeyDown = false;
+	bool bRKeyDown = false;
+	bool bGKeyDown = false;
+	bool bGScrolledWhileDown = false;
+	FVector2D LastMousePosition = FVector2D::ZeroVector;
+
+	// For Shift+Rotate to temporarily disable rotation snap
+	bool bTemporarilyDisabledRotSnap = false;
+
+	// For Q-hold cursor hiding and infinite movement
+	bool bCursorHidden = false;
+	FVector2D DragStartCursorPos = FVector2D::ZeroVector;
+	TSharedPtr<ICursor> CachedCursor;
+
+	// Unwarped cursor position for the current drag (start position plus all deltas)
+	FVector2D DragVirtualCursorPos = FVector2D::ZeroVector;
+
+	// Relative mouse input while the cursor is hidden: raw counts in high precision mouse mode,
+	// otherwise screen pixels with the cursor warped back only near the viewport edge
+	bool bRawMouseCaptured = false;
+	bool bHighPrecisionMouse = false;
+	FVector2D PendingRawMouseDelta = FVector2D::ZeroVector;
+	TWeakPtr<SWindow> RawMouseCaptureWindow;
+
+	// For precise cursor tracking - stores the initial offset from cursor to selection pivot
+	FVector DragStartWorldPos = FVector::ZeroVector;
+	FVector SelectionStartPivot = FVector::ZeroVector;
+
+	// For snap accumulation - tracks unsnapped movement
+	FVector AccumulatedMovement = FVector::ZeroVector;
+
+	// For R+Drag uniform scale - total accumulated delta (initial scales live in DragSession)
+	float TotalScaleDelta = 0.0f;
+
+	// Selection snapshot for the current Q/E/R drag
+	FShortcutDragSession DragSession;
+	FDelegateHandle SelectionChangedHandle;
+	FDelegateHandle SelectObjectHandle;
+
+	// Set while we broadcast our own selection notifications so they don't invalidate the snapshot
+	bool bIgnoreSelectionChange = false;
+
+	// Viewport client that owns the current Q/E/R drag (only this one redraws per frame)
+	FLevelEditorViewportClient* DragViewportClient = nullptr;
+
+	// Transaction for continuous drag operations (single undo for entire drag)
+	TUniquePtr<FScopedTransaction> DragTransaction;
+
+	// Alt+Q+Drag ground traces: ignore the dragged actors and their attachments
+	FCollisionQueryParams GroundQueryParams;
+
+	// Line batch ID for the bounding proxy in the persistent line batcher
+	static constexpr uint32 DragProxyBatchID = 0x4C455350;
+
+	void EndDragTransaction()
+	{
+		// Apply deferred proxy/physics/overlap updates while the drag transaction is still open
+		FlushDragSession();
+
+		if (DragTransaction.IsValid())
+		{
+			DragTransaction.Reset();
+		}
+		AccumulatedMovement = FVector::ZeroVector;
+		TotalScaleDelta = 0.0f;
+		DragSession.Reset();
+		DragViewportClient = nullptr;
+		DeprojectionCache.Reset();
+	}
+
+	void OnSelectionChanged(UObject* Object)
+	{
+		if (!bIgnoreSelectionChange)
+		{
+			FlushDragSession();
+			DragSession.Reset();
+		}
+	}
+
+	// Bring the real actors up to date with the snapshot: apply proxy transforms, then the
+	// physics/overlap/PostEditMove work the preview path skipped, then remove the proxy lines
+	void FlushDragSession()
+	{
+		// PostEditMove can trigger selection notifications - don't let them reset the session mid-loop
+		TGuardValue<bool> IgnoreGuard(bIgnoreSelectionChange, true);
+
+		if (DragSession.bProxyPending)
+		{
+			DragSession.bProxyPending = false;
+			DragSession.UpdateTargets(CVarParallelTransformThreshold.GetValueOnGameThread());
+			DragSession.NumPendingApply = DragSession.Num();
+
+			// The proxy doesn't follow the ground; the actors do once, at their final targets
+			if (DragSession.bProxyGroundFollow)
+			{
+				UpdateGroundFollow(false);
+			}
+		}
+
+		// Settle actors whose ground query didn't fit in the last frame's budget
+		if (DragSession.bGroundFollow && DragSession.NumGroundPending > 0)
+		{
+			UpdateGroundFollow(false);
+			DragSession.NumPendingApply = DragSession.Num();
+		}
+
+		// Finish any time-sliced update synchronously - the transaction closes right after
+		ApplyPendingDragTransforms(false, true);
+
+		CommitPreviewTransforms();
+
+		if (DragSession.bProxyMode)
+		{
+			ClearDragProxy();
+		}
+	}
+
+	// Full selection broadcast - refreshes the gizmo but also rebuilds the details panel
+	void BroadcastSelectionChange()
+	{
+		INC_DWORD_STAT(STAT_LevelEditorShortcuts_SelectionBroadcasts);
+		GEditor->NoteSelectionChange();
+	}
+
+	// Broadcast a selection change without dropping the drag snapshot
+	void NoteSelectionChangeKeepSession()
+	{
+		TGuardValue<bool> IgnoreGuard(bIgnoreSelectionChange, true);
+		BroadcastSelectionChange();
+	}
+
+	// Per-frame feedback while Q/E/R is held. By default only the gizmo pivot is moved;
+	// the full selection broadcast is sent once from HandleKeyUpEvent.
+	void NotifyDragFrame(const FVector& NewGizmoPivot)
+	{
+		INC_DWORD_STAT(STAT_LevelEditorShortcuts_DragFrames);
+
+		if (CVarDeferSelectionNotify.GetValueOnGameThread() != 0)
+		{
+			GLevelEditorModeTools().SetPivotLocation(NewGizmoPivot, false);
+		}
+		else
+		{
+			NoteSelectionChangeKeepSession();
+		}
+	}
+
+	// Move an actor for preview only: updates component transforms (render state and attached
+	// children) as a teleport, skipping physics bodies, overlaps and PostEditMove
+	static void SetActorPreviewTransform(AActor* Actor, const FTransform& WorldTransform)
+	{
+		USceneComponent* Root = Actor->GetRootComponent();
+		if (!Root)
+		{
+			return;
+		}
+
+		FTransform RelativeTransform = WorldTransform;
+		if (USceneComponent* Parent = Root->GetAttachParent())
+		{
+			RelativeTransform = WorldTransform.GetRelativeTransform(Parent->GetSocketTransform(Root->GetAttachSocketName()));
+		}
+
+		Root->SetRelativeLocation_Direct(RelativeTransform.GetLocation());
+		Root->SetRelativeRotation_Direct(RelativeTransform.Rotator());
+		Root->SetRelativeScale3D_Direct(RelativeTransform.GetScale3D());
+		Root->UpdateComponentToWorld(EUpdateTransformFlags::SkipPhysicsUpdate, ETeleportType::TeleportPhysics);
+	}
+
+	// Apply the physics, overlap and PostEditMove work that preview transforms skipped - once per drag
+	void CommitPreviewTransforms()
+	{
+		if (!DragSession.bPreviewPending)
+		{
+			return;
+		}
+		DragSession.bPreviewPending = false;
+
+		for (const TWeakObjectPtr<AActor>& ActorPtr : DragSession.Actors)
+		{
+			AActor* Actor = ActorPtr.Get();
+			if (!IsValid(Actor))
+			{
+				continue;
+			}
+
+			if (USceneComponent* Root = Actor->GetRootComponent())
+			{
+				// Teleport forces the physics push even though the component transform is unchanged
+				Root->UpdateComponentToWorld(EUpdateTransformFlags::None, ETeleportType::TeleportPhysics);
+			}
+			Actor->UpdateOverlaps();
+			Actor->PostEditMove(true);
+		}
+	}
+
+	// Move one snapshot actor to its current drag transform, through the preview path when enabled
+	void SetDragActorTransform(int32 Index, bool bPreview)
+	{
+		AActor* Actor = DragSession.Actors[Index].Get();
+		if (!IsValid(Actor))
+		{
+			return;
+		}
+
+		if (bPreview)
+		{
+			SetActorPreviewTransform(Actor, FTransform(DragSession.StartRotations[Index], DragSession.TargetLocations[Index], DragSession.TargetScales[Index]));
+			DragSession.bPreviewPending = true;
+		}
+		else
+		{
+			Actor->SetActorLocation(DragSession.TargetLocations[Index]);
+			Actor->SetActorScale3D(DragSession.TargetScales[Index]);
+			Actor->PostEditMove(false);
+		}
+	}
+
+	// Push the current drag state to the actors, or only to the bounding proxy for huge selections
+	void ApplyDragTransforms()
+	{
+		if (DragSession.bProxyMode)
+		{
+			DragSession.bProxyPending = true;
+			DragSession.bProxyGroundFollow = bQKeyDown && FSlateApplication::Get().GetModifierKeys().IsAltDown();
+			DrawDragProxy();
+			return;
+		}
+
+		// The newest drag state supersedes whatever previous frames didn't get to;
+		// the actual work happens in TickPendingDragTransforms within the frame budget
+		DragSession.UpdateTargets(CVarParallelTransformThreshold.GetValueOnGameThread());
+
+		if (bQKeyDown && FSlateApplication::Get().GetModifierKeys().IsAltDown())
+		{
+			UpdateGroundFollow(true);
+		}
+		else
+		{
+			DragSession.bGroundFollow = false;
+			DragSession.NumGroundPending = 0;
+		}
+
+		DragSession.NumPendingApply = DragSession.Num();
+	}
+
+	// Alt+Q+Drag: rest every actor on the ground under its dragged location with the ground snap
+	// rules (collision filter, lowest-vertex bottom offset). An actor is only re-queried once it
+	// crosses a cell; the height cache answers first and physics traces are capped per frame
+	// with bUseBudget, while the cache traces tiles ahead of the selection.
+	void UpdateGroundFollow(bool bUseBudget)
+	{
+		UWorld* World = GEditor->GetEditorWorldContext().World();
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 NumActors = DragSession.Num();
+		FGroundHeightCache* HeightCache = FGroundHeightCache::Get();
+
+		if (!DragSession.bGroundFollow)
+		{
+			DragSession.bGroundFollow = true;
+			DragSession.GroundCells.Init(FIntPoint(MAX_int32, MAX_int32), NumActors);
+			DragSession.GroundHeights.SetNumUninitialized(NumActors);
+			for (int32 i = 0; i < NumActors; i++)
+			{
+				DragSession.GroundHeights[i] = DragSession.TargetLocations[i].Z;
+			}
+
+			// Ground is whatever lies under the dragged actors, never the actors themselves
+			TArray<AActor*> DraggedActors;
+			TArray<AActor*> IgnoredActors;
+			for (const TWeakObjectPtr<AActor>& ActorPtr : DragSession.Actors)
+			{
+				if (AActor* Actor = ActorPtr.Get())
+				{
+					DraggedActors.Add(Actor);
+					IgnoredActors.Add(Actor);
+					Actor->GetAttachedActors(IgnoredActors, false, true);
+				}
+			}
+			GroundQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(LevelEditorShortcutsSurfaceDrag));
+			GroundQueryParams.AddIgnoredActors(IgnoredActors);
+
+			// Only the tiles around actors that joined or left the ignored set are dropped, and the
+			// first frame queues tiles under the same per-frame cap as the rest of the drag
+			if (HeightCache)
+			{
+				HeightCache->Prepare(World, DraggedActors);
+
+				TArray<FBox> Footprints;
+				Footprints.Reserve(DraggedActors.Num());
+				for (const AActor* Actor : DraggedActors)
+				{
+					FBox Bounds = Actor->GetComponentsBoundingBox(true, true);
+					Bounds += Actor->GetActorLocation();
+					Footprints.Add(Bounds);
+				}
+				HeightCache->RequestFootprints(Footprints, CVarSurfaceDragTilesPerFrame.GetValueOnGameThread());
+			}
+		}
+
+		const double CellSize = FMath::Max(1.0, (double)CVarSurfaceDragCellSize.GetValueOnGameThread());
+		int32 TraceBudget = bUseBudget ? CVarSurfaceDragTracesPerFrame.GetValueOnGameThread() : MAX_int32;
+		TArray<FBox> MissedFootprints;
+		DragSession.NumGroundPending = 0;
+
+		for (int32 i = 0; i < NumActors; i++)
+		{
+			FVector& Target = DragSession.TargetLocations[i];
+			AActor* Actor = DragSession.Actors[i].Get();
+			const FIntPoint Cell(FMath::FloorToInt32(Target.X / CellSize), FMath::FloorToInt32(Target.Y / CellSize));
+
+			if (Cell != DragSession.GroundCells[i] && IsValid(Actor))
+			{
+				// Start above the height the actor rests at now, so it can climb as well as descend
+				const double CurrentHeight = DragSession.GroundHeights[i];
+				const FVector TraceStart(Target.X, Target.Y, CurrentHeight + GroundSnap::TraceStartHeight);
+
+				FHitResult Hit;
+				bool bHit = HeightCache && HeightCache->Sample(TraceStart, Hit);
+				bool bResolved = bHit;
+				if (!bHit)
+				{
+					if (HeightCache)
+					{
+						MissedFootprints.Emplace(FVector(Target.X - CellSize, Target.Y - CellSize, CurrentHeight), FVector(Target.X + CellSize, Target.Y + CellSize, CurrentHeight));
+					}
+					if (TraceBudget > 0)
+					{
+						// No ground at all still resolves the cell: the actor keeps its height
+						TraceBudget--;
+						bHit = GroundSnap::TraceGroundAt(World, TraceStart, GroundQueryParams, Hit);
+						bResolved = true;
+					}
+				}
+
+				if (bHit)
+				{
+					DragSession.GroundHeights[i] = GroundSnap::CalcRestingHeight(Actor, DragSession.StartRotations[i], Hit);
+				}
+				if (bResolved)
+				{
+					DragSession.GroundCells[i] = Cell;
+				}
+				else
+				{
+					DragSession.NumGroundPending++;
+				}
+			}
+
+			Target.Z = DragSession.GroundHeights[i];
+		}
+
+		// Fill the cache where the selection is heading so later frames stay off physics
+		if (bUseBudget && HeightCache && MissedFootprints.Num() > 0)
+		{
+			HeightCache->RequestFootprints(MissedFootprints, CVarSurfaceDragTilesPerFrame.GetValueOnGameThread());
+		}
+	}
+
+	// Bring lagging actors up to the current drag state. With bUseBudget the work stops once
+	// LevelEditorShortcuts.DragApplyBudgetMs is spent and resumes from the same actor next frame.
+	// Returns true if any actor was updated.
+	bool ApplyPendingDragTransforms(bool bUseBudget, bool bPreview)
+	{
+		if (DragSession.NumPendingApply <= 0 || DragSession.Num() == 0)
+		{
+			return false;
+		}
+
+		const float BudgetMs = bUseBudget ? CVarDragApplyBudgetMs.GetValueOnGameThread() : 0.0f;
+		const double EndTime = FPlatformTime::Seconds() + BudgetMs * 0.001;
+
+		int32 NumApplied = 0;
+		while (DragSession.NumPendingApply > 0)
+		{
+			SetDragActorTransform(DragSession.ApplyCursor, bPreview);
+			DragSession.ApplyCursor = (DragSession.ApplyCursor + 1) % DragSession.Num();
+			DragSession.NumPendingApply--;
+			NumApplied++;
+
+			// Reading the clock isn't free - only check every few actors
+			if (BudgetMs > 0.0f && (NumApplied % 32) == 0 && FPlatformTime::Seconds() >= EndTime)
+			{
+				break;
+			}
+		}
+
+		INC_DWORD_STAT_BY(STAT_LevelEditorShortcuts_DragActorsApplied, NumApplied);
+		INC_DWORD_STAT_BY(STAT_LevelEditorShortcuts_DragActorsPending, DragSession.NumPendingApply);
+		return NumApplied > 0;
+	}
+
+	// Once per drag frame: spend the frame budget on actors still lagging behind
+	void TickPendingDragTransforms()
+	{
+		// Actors whose ground query didn't fit in the last frame's budget
+		if (DragSession.NumGroundPending > 0 && bQKeyDown)
+		{
+			ApplyDragTransforms();
+		}
+
+		const bool bPreview = CVarPreviewDragTransforms.GetValueOnGameThread() != 0;
+		if (ApplyPendingDragTransforms(true, bPreview))
+		{
+			RedrawDragViewport();
+		}
+	}
+
+	static void AddBoxLines(TArray<FBatchedLine>& Lines, const FBox& Box, const FLinearColor& Color, float Thickness)
+	{
+		const FVector& Min = Box.Min;
+		const FVector& Max = Box.Max;
+		const FVector Corners[8] =
+		{
+			FVector(Min.X, Min.Y, Min.Z), FVector(Max.X, Min.Y, Min.Z), FVector(Max.X, Max.Y, Min.Z), FVector(Min.X, Max.Y, Min.Z),
+			FVector(Min.X, Min.Y, Max.Z), FVector(Max.X, Min.Y, Max.Z), FVector(Max.X, Max.Y, Max.Z), FVector(Min.X, Max.Y, Max.Z)
+		};
+		for (int32 Edge = 0; Edge < 4; Edge++)
+		{
+			const int32 Next = (Edge + 1) % 4;
+			Lines.Emplace(Corners[Edge], Corners[Next], Color, -1.0f, Thickness, SDPG_Foreground, DragProxyBatchID);
+			Lines.Emplace(Corners[Edge + 4], Corners[Next + 4], Color, -1.0f, Thickness, SDPG_Foreground, DragProxyBatchID);
+			Lines.Emplace(Corners[Edge], Corners[Edge + 4], Color, -1.0f, Thickness, SDPG_Foreground, DragProxyBatchID);
+		}
+	}
+
+	static ULineBatchComponent* GetProxyLineBatcher()
+	{
+		UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+		return World ? World->GetLineBatcher(UWorld::ELineBatcherType::WorldPersistent) : nullptr;
+	}
+
+	// Draw the selection's combined bounds (and per-actor boxes, up to a cap) as one line batch
+	void DrawDragProxy()
+	{
+		ULineBatchComponent* LineBatcher = GetProxyLineBatcher();
+		if (!LineBatcher)
+		{
+			return;
+		}
+		LineBatcher->ClearBatch(DragProxyBatchID);
+
+		const bool bDrawActorBoxes = DragSession.Num() <= CVarProxyDragMaxBoxes.GetValueOnGameThread();
+
+		TArray<FBatchedLine> Lines;
+		Lines.Reserve(12 * ((bDrawActorBoxes ? DragSession.Num() : 0) + 1));
+
+		if (bDrawActorBoxes)
+		{
+			for (int32 i = 0; i < DragSession.Num(); i++)
+			{
+				AddBoxLines(Lines, DragSession.GetProxyBounds(i), FLinearColor(1.0f, 0.6f, 0.0f), 0.0f);
+			}
+		}
+		AddBoxLines(Lines, DragSession.GetCombinedBounds(), FLinearColor::Yellow, 2.0f);
+
+		LineBatcher->DrawLines(Lines);
+	}
+
+	void ClearDragProxy()
+	{
+		if (ULineBatchComponent* LineBatcher = GetProxyLineBatcher())
+		{
+			LineBatcher->ClearBatch(DragProxyBatchID);
+		}
+	}
+
+	// Make sure the drag snapshot exists, capturing it inside the drag transaction.
+	// Returns false if there is nothing to drag.
+	bool EnsureDragSession(const FText& Description)
+	{
+		EnsureDragTransaction(Description);
+		if (!DragSession.bValid)
+		{
+			// (Re)captured mid-drag after a selection change - start totals from the new snapshot
+			DragSession.Capture(GEditor->GetSelectedActors());
+			AccumulatedMovement = FVector::ZeroVector;
+			TotalScaleDelta = 0.0f;
+
+			// Very large selections drag a bounding proxy; real transforms are applied on key-up
+			const int32 ProxyThreshold = CVarProxyDragThreshold.GetValueOnGameThread();
+			if (ProxyThreshold > 0 && DragSession.Num() >= ProxyThreshold)
+			{
+				DragSession.bProxyMode = true;
+				DragSession.CaptureBounds();
+			}
+		}
+		return DragSession.bValid;
+	}
+
+	void SetCursorHidden(bool bHide)
+	{
+		if (bHide == bCursorHidden)
+		{
+			return;
+		}
+		bCursorHidden = bHide;
+		if (CachedCursor.IsValid())
+		{
+			CachedCursor->Show(!bHide);
+		}
+
+		if (bHide)
+		{
+			BeginRawMouseCapture();
+		}
+		else
+		{
+			EndRawMouseCapture();
+		}
 	}
 
-private:
-	bool bQKeyDown = false;
-	bool bQScrolledWhileDown = false;
-	bool bEKeyDown = false;
-	bool bRKeyDown = false;
-	bool bGKeyDown = false;
-	bool bGScrolledWhileDown = false;
-	FVector2D LastMousePosition = FVector2D::ZeroVector;
-
-	// For Shift+Rotate to temporarily disable rotation snap
-	bool bTemporarilyDisabledRotSnap = false;
-
-	// For Q-hold cursor hiding and infinite movement
-	bool bCursorHidden = false;
-	FVector2D DragStartCursorPos = FVector2D::ZeroVector;
-	TSharedPtr<ICursor> CachedCursor;
+	// Capture the hidden cursor so drags read deltas from HandleMouseMoveEvent instead of
+	// polling and warping the cursor every frame
+	void BeginRawMouseCapture()
+	{
+		if (bRawMouseCaptured || CVarRawMouseDrag.GetValueOnGameThread() == 0 || !FSlateApplication::IsInitialized())
+		{
+			return;
+		}
 
-	// For precise cursor tracking - stores the initial offset from cursor to selection pivot
-	FVector DragStartWorldPos = FVector::ZeroVector;
-	FVector SelectionStartPivot = FVector::ZeroVector;
-	bool bDragInitialized = false;
+		FSlateApplication& SlateApp = FSlateApplication::Get();
 
-	// For snap accumulation - tracks unsnapped movement
-	FVector AccumulatedMovement = FVector::ZeroVector;
+		// Cursor-locked Q+Drag deprojects DragVirtualCursorPos, which needs screen pixels. Raw deltas
+		// are device counts that only match pixels at 1:1 OS sensitivity without acceleration, so
+		// follow the real (hidden) cursor's pixel motion instead.
+		if (bQKeyDown && CVarCursorLockedDrag.GetValueOnGameThread() != 0)
+		{
+			LastMousePosition = SlateApp.GetCursorPos();
+			PendingRawMouseDelta = FVector2D::ZeroVector;
+			bHighPrecisionMouse = false;
+			bRawMouseCaptured = true;
+			return;
+		}
 
-	// For R+Drag uniform scale - stores initial scales at drag start and total accumulated delta
-	float TotalScaleDelta = 0.0f;
-	TArray<TPair<TWeakObjectPtr<AActor>, FVector>> ScaleDragInitialScales;
+		TSharedPtr<SWindow> Window = SlateApp.GetActiveTopLevelWindow();
+		if (!Window.IsValid() || !Window->GetNativeWindow().IsValid())
+		{
+			return; // Fall back to cursor warping
+		}
 
-	// Transaction for continuous drag operations (single undo for entire drag)
-	TUniquePtr<FScopedTransaction> DragTransaction;
+		SlateApp.GetPlatformApplication()->SetHighPrecisionMouseMode(true, Window->GetNativeWindow());
+		RawMouseCaptureWindow = Window;
+		PendingRawMouseDelta = FVector2D::ZeroVector;
+		bHighPrecisionMouse = true;
+		bRawMouseCaptured = true;
+	}
 
-	void EndDragTransaction()
+	void EndRawMouseCapture()
 	{
-		if (DragTransaction.IsValid())
+		if (!bRawMouseCaptured)
 		{
-			DragTransaction.Reset();
+			return;
 		}
-		bDragInitialized = false;
-		AccumulatedMovement = FVector::ZeroVector;
-		TotalScaleDelta = 0.0f;
-		ScaleDragInitialScales.Empty();
+		bRawMouseCaptured = false;
+		PendingRawMouseDelta = FVector2D::ZeroVector;
+
+		if (FSlateApplication::IsInitialized())
+		{
+			FSlateApplication& SlateApp = FSlateApplication::Get();
+			if (bHighPrecisionMouse)
+			{
+				TSharedPtr<SWindow> Window = RawMouseCaptureWindow.Pin();
+				SlateApp.GetPlatformApplication()->SetHighPrecisionMouseMode(false, Window.IsValid() ? Window->GetNativeWindow() : nullptr);
+			}
+
+			// One warp at the end so the cursor reappears where the drag started
+			SlateApp.SetCursorPos(DragStartCursorPos);
+		}
+		RawMouseCaptureWindow.Reset();
+		bHighPrecisionMouse = false;
 	}
 
-	void SetCursorHidden(bool bHide)
+	// Pixel capture: once the hidden cursor gets near the drag viewport's edge, put it back in the
+	// middle so it never leaves the viewport. Motion up to here is already in PendingRawMouseDelta.
+	void WarpCapturedCursorFromViewportEdge(FSlateApplication& SlateApp)
 	{
-		if (bHide == bCursorHidden)
+		FLevelEditorViewportClient* ViewportClient = GetDragViewportClient();
+		FSceneViewport* SceneViewport = ViewportClient ? static_cast<FSceneViewport*>(ViewportClient->Viewport) : nullptr;
+		if (!SceneViewport)
 		{
 			return;
 		}
-		bCursorHidden = bHide;
-		if (CachedCursor.IsValid())
+
+		const FGeometry& Geometry = SceneViewport->GetCachedGeometry();
+		const FVector2D LocalSize = Geometry.GetLocalSize();
+		const FVector2D LocalPos = Geometry.AbsoluteToLocal(LastMousePosition);
+		const FVector2D Margin = LocalSize * CapturedCursorEdgeMargin;
+		if (LocalPos.X > Margin.X && LocalPos.Y > Margin.Y && LocalPos.X < LocalSize.X - Margin.X && LocalPos.Y < LocalSize.Y - Margin.Y)
 		{
-			CachedCursor->Show(!bHide);
+			return;
 		}
+
+		LastMousePosition = Geometry.LocalToAbsolute(LocalSize * 0.5f);
+		SlateApp.SetCursorPos(LastMousePosition);
 	}
 
 	void EnsureDragTransaction(const FText& Description)
@@ -454,6 +1393,31 @@ private:
 		return nullptr;
 	}
 
+	// Viewport the current drag started in, falling back to the active one if it has gone away
+	FLevelEditorViewportClient* GetDragViewportClient()
+	{
+		if (DragViewportClient && GEditor && GEditor->GetLevelViewportClients().Contains(DragViewportClient))
+		{
+			return DragViewportClient;
+		}
+		return GetActiveViewportClient();
+	}
+
+	// Per-frame redraw of only the viewport that owns the drag.
+	// The other viewports get one full refresh from HandleKeyUpEvent.
+	void RedrawDragViewport()
+	{
+		if (FLevelEditorViewportClient* ViewportClient = GetDragViewportClient())
+		{
+			// Hit proxies are rebuilt by the full redraw on key-up
+			ViewportClient->Invalidate(false, false);
+		}
+		else
+		{
+			GEditor->RedrawLevelEditingViewports();
+		}
+	}
+
 	// Check if Level Editor viewport is focused
 	bool IsLevelEditorViewportFocused()
 	{
@@ -520,40 +1484,60 @@ private:
 		return 0.0f;
 	}
 
-	// Get selection pivot (center of selected actors)
+	// Get selection pivot (center of selected actors) from the drag snapshot
 	FVector GetSelectionPivot()
 	{
-		if (!GEditor)
+		return DragSession.GetPivot();
+	}
+
+	// Cached deprojection for one viewport. Checked at most once per frame and only rebuilt
+	// (one CalcSceneView) when the camera or viewport size changed since the last build.
+	struct FViewportDeprojection
+	{
+		FVector ViewLocation = FVector::ZeroVector;
+		FRotator ViewRotation = FRotator::ZeroRotator;
+		float ViewFOV = 0.0f;
+		float OrthoZoom = 0.0f;
+		ELevelViewportType ViewportType = LVT_Perspective;
+		FIntPoint ViewportSize = FIntPoint::ZeroValue;
+		FIntRect ViewRect;
+		FMatrix InvViewProjectionMatrix = FMatrix::Identity;
+		uint64 LastCheckedFrame = MAX_uint64;
+		bool bValid = false;
+	};
+	TMap<FLevelEditorViewportClient*, FViewportDeprojection> DeprojectionCache;
+
+	const FViewportDeprojection* GetViewportDeprojection(FLevelEditorViewportClient* ViewportClient)
+	{
+		if (!ViewportClient || !ViewportClient->Viewport)
 		{
-			return FVector::ZeroVector;
+			return nullptr;
 		}
 
-		USelection* Selection = GEditor->GetSelectedActors();
-		if (!Selection || Selection->Num() == 0)
+		FViewportDeprojection& Cache = DeprojectionCache.FindOrAdd(ViewportClient);
+		if (Cache.LastCheckedFrame == GFrameCounter)
 		{
-			return FVector::ZeroVector;
+			return Cache.bValid ? &Cache : nullptr;
 		}
+		Cache.LastCheckedFrame = GFrameCounter;
 
-		FVector Sum = FVector::ZeroVector;
-		int32 Count = 0;
-		for (int32 i = 0; i < Selection->Num(); i++)
+		const FIntPoint ViewportSize = ViewportClient->Viewport->GetSizeXY();
+		const bool bCameraChanged = !Cache.bValid
+			|| Cache.ViewportSize != ViewportSize
+			|| Cache.ViewportType != ViewportClient->GetViewportType()
+			|| Cache.ViewFOV != ViewportClient->ViewFOV
+			|| Cache.OrthoZoom != ViewportClient->GetOrthoZoom()
+			|| !Cache.ViewLocation.Equals(ViewportClient->GetViewLocation())
+			|| !Cache.ViewRotation.Equals(ViewportClient->GetViewRotation());
+		if (!bCameraChanged)
 		{
-			AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i));
-			if (Actor)
-			{
-				Sum += Actor->GetActorLocation();
-				Count++;
-			}
+			return &Cache;
 		}
-		return Count > 0 ? Sum / Count : FVector::ZeroVector;
-	}
 
-	// Project screen position to world position on a horizontal plane at given Z
-	bool ScreenToWorldOnPlane(FLevelEditorViewportClient* ViewportClient, const FVector2D& ScreenPos, float PlaneZ, FVector& OutWorldPos)
-	{
-		if (!ViewportClient)
+		Cache.bValid = false;
+		if (ViewportSize.X <= 0 || ViewportSize.Y <= 0)
 		{
-			return false;
+			return nullptr;
 		}
 
 		FSceneViewFamilyContext ViewFamily(FSceneViewFamily::ConstructionValues(
@@ -564,84 +1548,99 @@ private:
 		FSceneView* View = ViewportClient->CalcSceneView(&ViewFamily);
 		if (!View)
 		{
-			return false;
+			return nullptr;
 		}
 
-		// Deproject screen to world ray
-		FVector WorldOrigin, WorldDirection;
-		FMatrix InvViewProjMatrix = View->ViewMatrices.GetInvViewProjectionMatrix();
-
-		// Convert screen pos to normalized device coordinates
-		FIntRect ViewRect = View->UnscaledViewRect;
-		float NormX = (ScreenPos.X - ViewRect.Min.X) / (float)ViewRect.Width() * 2.0f - 1.0f;
-		float NormY = 1.0f - (ScreenPos.Y - ViewRect.Min.Y) / (float)ViewRect.Height() * 2.0f;
-
-		FVector4 Near = InvViewProjMatrix.TransformFVector4(FVector4(NormX, NormY, 0.0f, 1.0f));
-		FVector4 Far = InvViewProjMatrix.TransformFVector4(FVector4(NormX, NormY, 1.0f, 1.0f));
-
-		WorldOrigin = FVector(Near) / Near.W;
-		FVector WorldEnd = FVector(Far) / Far.W;
-		WorldDirection = (WorldEnd - WorldOrigin).GetSafeNormal();
+		Cache.InvViewProjectionMatrix = View->ViewMatrices.GetInvViewProjectionMatrix();
+		Cache.ViewRect = View->UnscaledViewRect;
+		Cache.ViewportSize = ViewportSize;
+		Cache.ViewportType = ViewportClient->GetViewportType();
+		Cache.ViewFOV = ViewportClient->ViewFOV;
+		Cache.OrthoZoom = ViewportClient->GetOrthoZoom();
+		Cache.ViewLocation = ViewportClient->GetViewLocation();
+		Cache.ViewRotation = ViewportClient->GetViewRotation();
+		Cache.bValid = true;
+		return &Cache;
+	}
 
-		// Intersect ray with horizontal plane at PlaneZ
-		if (FMath::Abs(WorldDirection.Z) < KINDA_SMALL_NUMBER)
+	// Convert an absolute (desktop) Slate position to the viewport's pixel coordinates.
+	// Positions outside the viewport are fine - the hidden drag cursor is virtual.
+	bool AbsoluteToViewportPixel(FLevelEditorViewportClient* ViewportClient, const FVector2D& AbsolutePos, FVector2D& OutPixelPos)
+	{
+		FSceneViewport* SceneViewport = static_cast<FSceneViewport*>(ViewportClient->Viewport);
+		if (!SceneViewport)
 		{
-			return false; // Ray is parallel to plane
+			return false;
 		}
 
-		float T = (PlaneZ - WorldOrigin.Z) / WorldDirection.Z;
-		if (T < 0)
+		const FGeometry& Geometry = SceneViewport->GetCachedGeometry();
+		const FVector2D LocalSize = Geometry.GetLocalSize();
+		if (LocalSize.X <= 0.0f || LocalSize.Y <= 0.0f)
 		{
-			return false; // Intersection is behind camera
+			return false;
 		}
 
-		OutWorldPos = WorldOrigin + WorldDirection * T;
+		const FVector2D PixelSize(SceneViewport->GetSizeXY());
+		OutPixelPos = Geometry.AbsoluteToLocal(AbsolutePos) * PixelSize / LocalSize;
 		return true;
 	}
 
-	void MoveSelectedActorsHorizontal(const FVector2D& MouseDelta)
+	// Project an absolute screen position onto a plane through PlanePoint (perspective or ortho)
+	bool ScreenToWorldOnPlane(FLevelEditorViewportClient* ViewportClient, const FVector2D& ScreenPos, const FVector& PlanePoint, const FVector& PlaneNormal, FVector& OutWorldPos)
 	{
-		if (!GEditor)
+		const FViewportDeprojection* Deprojection = GetViewportDeprojection(ViewportClient);
+		FVector2D PixelPos;
+		if (!Deprojection || !AbsoluteToViewportPixel(ViewportClient, ScreenPos, PixelPos))
 		{
-			return;
+			return false;
 		}
 
-		USelection* Selection = GEditor->GetSelectedActors();
-		if (!Selection || Selection->Num() == 0)
+		// Deproject screen to world ray (ortho views get parallel rays with varying origins)
+		FVector WorldOrigin, WorldDirection;
+		FSceneView::DeprojectScreenToWorld(PixelPos, Deprojection->ViewRect, Deprojection->InvViewProjectionMatrix, WorldOrigin, WorldDirection);
+
+		const double Denominator = FVector::DotProduct(WorldDirection, PlaneNormal);
+		if (FMath::Abs(Denominator) < KINDA_SMALL_NUMBER)
 		{
-			return;
+			return false; // Ray is parallel to plane
 		}
 
-		FLevelEditorViewportClient* ViewportClient = GetActiveViewportClient();
-		if (!ViewportClient)
+		const double T = FVector::DotProduct(PlanePoint - WorldOrigin, PlaneNormal) / Denominator;
+		if (T < 0.0)
 		{
-			return;
+			return false; // Intersection is behind camera
 		}
 
-		// Initialize transaction on first movement
-		if (!bDragInitialized)
+		OutWorldPos = WorldOrigin + WorldDirection * T;
+		return true;
+	}
+
+	// Exact cursor-locked movement: where the virtual drag cursor's ray hits the movement plane
+	// now, minus where it hit before this frame's delta
+	bool CalcCursorLockedPlaneDelta(FLevelEditorViewportClient* ViewportClient, const FVector2D& MouseDelta, const FVector& PlaneNormal, FVector& OutWorldDelta)
+	{
+		// DragVirtualCursorPos only follows the real pixel path outside high precision mouse mode
+		// (a raw capture started by an E/R drag can still be active)
+		if (CVarCursorLockedDrag.GetValueOnGameThread() == 0 || (bRawMouseCaptured && bHighPrecisionMouse))
 		{
-			bDragInitialized = true;
-			EnsureDragTransaction(FText::FromString(TEXT("Move Horizontal")));
+			return false;
 		}
 
-		// Determine movement plane based on local/world coordinate system
-		ECoordSystem CoordSystem = GLevelEditorModeTools().GetCoordSystem();
-		FVector PlaneNormal = FVector::UpVector;
-
-		if (CoordSystem == COORD_Local)
+		const FVector PlanePoint = GetSelectionPivot();
+		FVector PreviousHit, CurrentHit;
+		if (!ScreenToWorldOnPlane(ViewportClient, DragVirtualCursorPos - MouseDelta, PlanePoint, PlaneNormal, PreviousHit)
+			|| !ScreenToWorldOnPlane(ViewportClient, DragVirtualCursorPos, PlanePoint, PlaneNormal, CurrentHit))
 		{
-			for (int32 i = 0; i < Selection->Num(); i++)
-			{
-				AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i));
-				if (Actor)
-				{
-					PlaneNormal = Actor->GetActorRotation().Quaternion().GetUpVector();
-					break;
-				}
-			}
+			return false; // Near the horizon - use the approximation instead
 		}
 
+		OutWorldDelta = CurrentHit - PreviousHit;
+		return true;
+	}
+
+	// Approximate movement from camera distance and FOV, used when the cursor ray misses the plane
+	FVector CalcApproximatePlaneDelta(FLevelEditorViewportClient* ViewportClient, const FVector2D& MouseDelta, const FVector& PlaneNormal)
+	{
 		// Get camera vectors and project onto movement plane
 		FRotator CameraRotation = ViewportClient->GetViewRotation();
 		FVector CameraForward = CameraRotation.Vector();
@@ -673,7 +1672,43 @@ private:
 		WorldUnitsPerPixel *= 0.4f;
 
 		// Convert mouse delta to world movement on the plane
-		FVector WorldDelta = (CameraRight * MouseDelta.X + CameraForward * -MouseDelta.Y) * WorldUnitsPerPixel;
+		return (CameraRight * MouseDelta.X + CameraForward * -MouseDelta.Y) * WorldUnitsPerPixel;
+	}
+
+	void MoveSelectedActorsHorizontal(const FVector2D& MouseDelta)
+	{
+		if (!GEditor)
+		{
+			return;
+		}
+
+		FLevelEditorViewportClient* ViewportClient = GetDragViewportClient();
+		if (!ViewportClient)
+		{
+			return;
+		}
+
+		// Initialize transaction and selection snapshot on first movement
+		if (!EnsureDragSession(FText::FromString(TEXT("Move Horizontal"))))
+		{
+			return;
+		}
+
+		// Determine movement plane based on local/world coordinate system
+		ECoordSystem CoordSystem = GLevelEditorModeTools().GetCoordSystem();
+		FVector PlaneNormal = FVector::UpVector;
+
+		if (CoordSystem == COORD_Local)
+		{
+			PlaneNormal = DragSession.StartRotations[0].GetUpVector();
+		}
+
+		// Keep the actors locked under the (virtual) cursor: intersect its ray with the movement plane
+		FVector WorldDelta;
+		if (!CalcCursorLockedPlaneDelta(ViewportClient, MouseDelta, PlaneNormal, WorldDelta))
+		{
+			WorldDelta = CalcApproximatePlaneDelta(ViewportClient, MouseDelta, PlaneNormal);
+		}
 
 		// Accumulate movement
 		AccumulatedMovement += WorldDelta;
@@ -717,20 +1752,17 @@ private:
 		}
 
 		// Apply movement to all selected actors
-		for (int32 i = 0; i < Selection->Num(); i++)
-		{
-			AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i));
-			if (Actor)
-			{
-				Actor->Modify();
-				FVector NewLocation = Actor->GetActorLocation() + ActualDelta;
-				Actor->SetActorLocation(NewLocation);
-				Actor->PostEditMove(false);
-			}
-		}
+		ApplyDragOffset(ActualDelta);
+	}
 
-		GEditor->NoteSelectionChange();
-		GEditor->RedrawLevelEditingViewports();
+	// Offset every snapshot actor from its drag-start location
+	void ApplyDragOffset(const FVector& ActualDelta)
+	{
+		DragSession.AppliedOffset += ActualDelta;
+		ApplyDragTransforms();
+
+		NotifyDragFrame(GLevelEditorModeTools().PivotLocation + ActualDelta);
+		RedrawDragViewport();
 	}
 
 	void MoveSelectedActorsVertical(float MouseDeltaY)
@@ -740,23 +1772,16 @@ private:
 			return;
 		}
 
-		USelection* Selection = GEditor->GetSelectedActors();
-		if (!Selection || Selection->Num() == 0)
-		{
-			return;
-		}
-
-		FLevelEditorViewportClient* ViewportClient = GetActiveViewportClient();
+		FLevelEditorViewportClient* ViewportClient = GetDragViewportClient();
 		if (!ViewportClient)
 		{
 			return;
 		}
 
-		// Initialize transaction on first movement
-		if (!bDragInitialized)
+		// Initialize transaction and selection snapshot on first movement
+		if (!EnsureDragSession(FText::FromString(TEXT("Move Vertical"))))
 		{
-			bDragInitialized = true;
-			EnsureDragTransaction(FText::FromString(TEXT("Move Vertical")));
+			return;
 		}
 
 		// Determine vertical axis based on local/world coordinate system
@@ -765,15 +1790,7 @@ private:
 
 		if (CoordSystem == COORD_Local)
 		{
-			for (int32 i = 0; i < Selection->Num(); i++)
-			{
-				AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i));
-				if (Actor)
-				{
-					VerticalAxis = Actor->GetActorRotation().Quaternion().GetUpVector();
-					break;
-				}
-			}
+			VerticalAxis = DragSession.StartRotations[0].GetUpVector();
 		}
 
 		// Use same FOV-based calculation as horizontal movement for consistent feel at distance
@@ -839,20 +1856,7 @@ private:
 			AccumulatedMovement = FVector::ZeroVector;
 		}
 
-		for (int32 i = 0; i < Selection->Num(); i++)
-		{
-			AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i));
-			if (Actor)
-			{
-				Actor->Modify();
-				FVector NewLocation = Actor->GetActorLocation() + ActualDelta;
-				Actor->SetActorLocation(NewLocation);
-				Actor->PostEditMove(false);
-			}
-		}
-
-		GEditor->NoteSelectionChange();
-		GEditor->RedrawLevelEditingViewports();
+		ApplyDragOffset(ActualDelta);
 	}
 
 	void ScaleSelectedActorsUniform(const FVector2D& MouseDelta)
@@ -862,27 +1866,10 @@ private:
 			return;
 		}
 
-		USelection* Selection = GEditor->GetSelectedActors();
-		if (!Selection || Selection->Num() == 0)
-		{
-			return;
-		}
-
 		// Initialize transaction and capture initial scales on first movement
-		if (!bDragInitialized)
+		if (!EnsureDragSession(FText::FromString(TEXT("Scale Uniform"))))
 		{
-			bDragInitialized = true;
-			EnsureDragTransaction(FText::FromString(TEXT("Scale Uniform")));
-
-			ScaleDragInitialScales.Empty();
-			for (int32 i = 0; i < Selection->Num(); i++)
-			{
-				AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i));
-				if (Actor)
-				{
-					ScaleDragInitialScales.Add(TPair<TWeakObjectPtr<AActor>, FVector>(Actor, Actor->GetActorScale3D()));
-				}
-			}
+			return;
 		}
 
 		// Outward = right or up increases scale, left or down decreases
@@ -908,23 +1895,12 @@ private:
 			}
 		}
 
-		for (auto& Pair : ScaleDragInitialScales)
-		{
-			AActor* Actor = Pair.Key.Get();
-			if (!Actor)
-			{
-				continue;
-			}
-
-			Actor->Modify();
-			FVector NewScale = Pair.Value * ScaleMultiplier;
-			NewScale = NewScale.ComponentMax(FVector(0.001f));
-			Actor->SetActorScale3D(NewScale);
-			Actor->PostEditMove(false);
-		}
+		DragSession.AppliedScale = ScaleMultiplier;
+		ApplyDragTransforms();
 
-		GEditor->NoteSelectionChange();
-		GEditor->RedrawLevelEditingViewports();
+		// Uniform scale keeps actor locations, so the gizmo stays put
+		NotifyDragFrame(GLevelEditorModeTools().PivotLocation);
+		RedrawDragViewport();
 	}
 
 	void RotateSelectedActors(float ScrollDelta, bool bIgnoreSnap = false)
@@ -961,73 +1937,81 @@ private:
 			}
 		}
 
-		// Collect actors to rotate and check for groups
-		TArray<AActor*> ActorsToRotate;
-		AGroupActor* GroupActor = nullptr;
+		// Create undo transaction (merges into the drag transaction while Q is dragging)
+		FScopedTransaction Transaction(FText::FromString(TEXT("Rotate Selected")));
 
-		for (int32 i = 0; i < Selection->Num(); i++)
+		// Reuse the drag snapshot if one is active, otherwise take a one-off snapshot
+		FShortcutDragSession LocalSession;
+		FShortcutDragSession& Session = DragSession.bValid ? DragSession : LocalSession;
+		if (!Session.bValid)
 		{
-			AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i));
-			if (Actor)
-			{
-				// Check if this actor is part of a group (GetRootForActor is exported, GetParentForActor is not)
-				if (!GroupActor)
-				{
-					GroupActor = AGroupActor::GetRootForActor(Actor);
-				}
-				ActorsToRotate.Add(Actor);
-			}
+			Session.Capture(Selection);
 		}
-
-		if (ActorsToRotate.Num() == 0)
+		if (Session.Num() == 0)
 		{
 			return;
 		}
 
-		// Create undo transaction
-		FScopedTransaction Transaction(FText::FromString(TEXT("Rotate Selected")));
-
 		// Determine pivot point for rotation
 		// If grouped or multiple selection, rotate around the center
 		// If single actor, rotate around its own pivot
-		FVector RotationPivot = FVector::ZeroVector;
-		bool bRotateAroundPivot = (ActorsToRotate.Num() > 1) || (GroupActor != nullptr);
-
-		if (bRotateAroundPivot)
-		{
-			// Calculate center of all actors
-			for (AActor* Actor : ActorsToRotate)
-			{
-				RotationPivot += Actor->GetActorLocation();
-			}
-			RotationPivot /= ActorsToRotate.Num();
-		}
+		// The cached center is reused (O(1)), and rotating about it leaves it unchanged
+		bool bRotateAroundPivot = (Session.Num() > 1) || Session.bHasGroup;
+		FVector RotationPivot = bRotateAroundPivot ? Session.GetPivot() : FVector::ZeroVector;
 
 		// Create rotation transform around Z axis
 		FQuat RotationQuat = FQuat(FVector::UpVector, FMath::DegreesToRadians(RotationAmount));
 
-		for (AActor* Actor : ActorsToRotate)
+		// PostEditMove must not drop the snapshot we are iterating
+		TGuardValue<bool> IgnoreGuard(bIgnoreSelectionChange, true);
+
+		// Rotation starts from the actors' real transforms - catch up any time-sliced update first
+		if (!Session.bProxyMode)
 		{
-			Actor->Modify();
+			ApplyPendingDragTransforms(false, CVarPreviewDragTransforms.GetValueOnGameThread() != 0);
+		}
+
+		// Rotate positions around the pivot point and each actor's own yaw (world Z).
+		// Pure array math, so large selections compute it on worker threads.
+		Session.RotateAboutZ(RotationQuat, bRotateAroundPivot, CVarParallelTransformThreshold.GetValueOnGameThread());
 
-			if (bRotateAroundPivot)
+		if (Session.bProxyMode)
+		{
+			// Only the snapshot and the proxy turn; the actors get the rotation with the rest of the
+			// proxy drag on key-up (the flush applies StartRotations)
+			Session.ProxyRotation = RotationQuat * Session.ProxyRotation;
+			Session.bProxyPending = true;
+			DrawDragProxy();
+		}
+		else
+		{
+			// Applying to the actors stays on the game thread
+			for (int32 i = 0; i < Session.Num(); i++)
 			{
-				// Rotate position around the pivot point
-				FVector RelativePos = Actor->GetActorLocation() - RotationPivot;
-				FVector NewRelativePos = RotationQuat.RotateVector(RelativePos);
-				Actor->SetActorLocation(RotationPivot + NewRelativePos);
-			}
+				AActor* Actor = Session.Actors[i].Get();
+				if (!IsValid(Actor))
+				{
+					continue;
+				}
 
-			// Also rotate the actor's own yaw
-			FRotator CurrentRotation = Actor->GetActorRotation();
-			CurrentRotation.Yaw += RotationAmount;
-			Actor->SetActorRotation(CurrentRotation);
+				if (bRotateAroundPivot)
+				{
+					Actor->SetActorLocation(Session.GetLocation(i));
+				}
+				Actor->SetActorRotation(Session.StartRotations[i]);
 
-			Actor->PostEditMove(true);
+				Actor->PostEditMove(true);
+			}
 		}
 
-		GEditor->NoteSelectionChange();
-		GEditor->RedrawLevelEditingViewports();
+		// Swing the gizmo with the actors; Q key-up sends the full selection broadcast
+		FVector GizmoPivot = GLevelEditorModeTools().PivotLocation;
+		if (bRotateAroundPivot)
+		{
+			GizmoPivot = RotationPivot + RotationQuat.RotateVector(GizmoPivot - RotationPivot);
+		}
+		NotifyDragFrame(GizmoPivot);
+		RedrawDragViewport();
 	}
 
 	void ToggleGridSnap()
@@ -1083,6 +2067,46 @@ private:
 
 TSharedPtr<FLevelEditorShortcutsProcessor> FLevelEditorShortcutsProcessor::Instance;
 
+// LevelEditorShortcuts.BenchmarkDragMath - times the per-actor drag math on synthetic data,
+// single-threaded vs ParallelFor, for 1k to 100k actors
+static void RunDragMathBenchmark()
+{
+	using TransformKernels::TimeBenchmarkMs;
+
+	for (int32 NumActors : TransformKernels::GetBenchmarkActorCounts())
+	{
+		FShortcutDragSession Session;
+		Session.StartLocations.SetNumUninitialized(NumActors);
+		Session.StartRotations.SetNumUninitialized(NumActors);
+		Session.StartScales.SetNumUninitialized(NumActors);
+		for (int32 i = 0; i < NumActors; i++)
+		{
+			Session.StartLocations[i] = FMath::VRand() * FMath::FRandRange(0.0f, 100000.0f);
+			Session.StartRotations[i] = FRotator(0.0f, FMath::FRandRange(-180.0f, 180.0f), 0.0f).Quaternion();
+			Session.StartScales[i] = FVector(FMath::FRandRange(0.5f, 2.0f));
+		}
+		Session.AppliedOffset = FVector(10.0f, -20.0f, 5.0f);
+		Session.AppliedScale = 1.25f;
+
+		const FQuat Rotation(FVector::UpVector, FMath::DegreesToRadians(15.0f));
+
+		const double TargetsSingle = TimeBenchmarkMs([&Session]() { Session.UpdateTargets(MAX_int32); });
+		const double TargetsParallel = TimeBenchmarkMs([&Session]() { Session.UpdateTargets(0); });
+		const double RotateSingle = TimeBenchmarkMs([&Session, &Rotation]() { Session.RotateAboutZ(Rotation, true, MAX_int32); });
+		const double RotateParallel = TimeBenchmarkMs([&Session, &Rotation]() { Session.RotateAboutZ(Rotation, true, 0); });
+
+		UE_LOG(LogLevelEditorShortcuts, Display, TEXT("%6d actors: move/scale targets %.3f ms -> %.3f ms (x%.1f), rotate %.3f ms -> %.3f ms (x%.1f)"),
+			NumActors,
+			TargetsSingle, TargetsParallel, TargetsSingle / FMath::Max(TargetsParallel, UE_SMALL_NUMBER),
+			RotateSingle, RotateParallel, RotateSingle / FMath::Max(RotateParallel, UE_SMALL_NUMBER));
+	}
+}
+
+static FAutoConsoleCommand BenchmarkDragMathCommand(
+	TEXT("LevelEditorShortcuts.BenchmarkDragMath"),
+	TEXT("Times per-actor drag transform math for 1k-100k synthetic actors, single-threaded vs ParallelFor."),
+	FConsoleCommandDelegate::CreateStatic(&RunDragMathBenchmark));
+
 // Namespace for module registration
 namespace LevelEditorShortcuts
 {
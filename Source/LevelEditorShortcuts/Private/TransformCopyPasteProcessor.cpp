@@ -13,18 +13,19 @@
 #include "Editor/UnrealEdEngine.h"
 #include "Engine/Selection.h"
 #include "Engine/World.h"
-#include "EngineUtils.h" // For TActorIterator
 #include "GameFramework/Actor.h"
 #include "ScopedTransaction.h"
-#include "Components/PrimitiveComponent.h"
-#include "Components/SkeletalMeshComponent.h"
-#include "Components/StaticMeshComponent.h"
-
-#if PLATFORM_WINDOWS
-#include "Windows/AllowWindowsPlatformTypes.h"
-#include <windows.h>
-#include "Windows/HideWindowsPlatformTypes.h"
-#endif
+#include "HAL/IConsoleManager.h"
+#include "GroundSnap.h"
+#include "ActorDuplication.h"
+#include "FolderAssignment.h"
+#include "LandscapeGround.h"
+
+static TAutoConsoleVariable<int32> CVarAsyncSnapThreshold(
+	TEXT("LevelEditorShortcuts.AsyncSnapThreshold"),
+	500,
+	TEXT("Snap to ground selections of at least this many actors are traced asynchronously over several frames and applied in one transaction. 0 = always synchronous."),
+	ECVF_Default);
 
 class FTransformCopyPasteProcessor : public IInputProcessor
 {
@@ -33,11 +34,6 @@ public:
 	static FTransform CopiedTransform;
 	static bool bHasCopiedTransform;
 
-	// For deferred paste-to-folder
-	static FName PendingPasteFolderPath;
-	static TSet<AActor*> ActorsBeforePaste;
-	static bool bPasteToFolderPending;
-
 	static void Register()
 	{
 		if (!Instance.IsValid() && FSlateApplication::IsInitialized())
@@ -59,11 +55,10 @@ public:
 
 	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override
 	{
-		// Handle deferred paste-to-folder
-		if (bPasteToFolderPending)
+		// Collect async ground snap results
+		if (SnapBatch.IsValid() && !SnapBatch->Tick())
 		{
-			bPasteToFolderPending = false;
-			CompletePasteToFolder();
+			SnapBatch.Reset();
 		}
 	}
 
@@ -75,6 +70,14 @@ public:
 			return false;
 		}
 
+		// Esc cancels a running async ground snap
+		if (SnapBatch.IsValid() && InKeyEvent.GetKey() == EKeys::Escape)
+		{
+			SnapBatch->Cancel();
+			SnapBatch.Reset();
+			return true;
+		}
+
 		// Shift+B (without Ctrl) - Snap to ground (keeps world up rotation)
 		// Check this BEFORE the Ctrl check so it doesn't get skipped
 		if (InKeyEvent.GetKey() == EKeys::B && InKeyEvent.IsShiftDown() && !InKeyEvent.IsControlDown())
@@ -128,33 +131,10 @@ public:
 		// Ctrl+Shift+V - Paste into selected folder
 		if (InKeyEvent.GetKey() == EKeys::V && InKeyEvent.IsShiftDown())
 		{
-			SetupPasteToFolder();
-
-			// Use Windows API to simulate Ctrl+V keypress
-			// This ensures we use the exact same paste path as manual Ctrl+V
-			INPUT inputs[4] = {};
-
-			// Key down: Ctrl
-			inputs[0].type = INPUT_KEYBOARD;
-			inputs[0].ki.wVk = VK_CONTROL;
-
-			// Key down: V
-			inputs[1].type = INPUT_KEYBOARD;
-			inputs[1].ki.wVk = 'V';
-
-			// Key up: V
-			inputs[2].type = INPUT_KEYBOARD;
-			inputs[2].ki.wVk = 'V';
-			inputs[2].ki.dwFlags = KEYEVENTF_KEYUP;
-
-			// Key up: Ctrl
-			inputs[3].type = INPUT_KEYBOARD;
-			inputs[3].ki.wVk = VK_CONTROL;
-			inputs[3].ki.dwFlags = KEYEVENTF_KEYUP;
-
-			SendInput(4, inputs, sizeof(INPUT));
-
-			return true; // Consume the original Ctrl+Shift+V
+			if (PasteToFolder())
+			{
+				return true; // Consume the event
+			}
 		}
 
 		return false;
@@ -171,6 +151,9 @@ public:
 	}
 
 private:
+	// Async ground snap in progress (large selections only)
+	TSharedPtr<FGroundSnapBatch> SnapBatch;
+
 	void CopySelectedTransform()
 	{
 		if (!GEditor)
@@ -237,6 +220,17 @@ private:
 	}
 
 	bool SnapSelectedToGround()
+	{
+		return SnapSelection(true, TEXT("Snap to Ground"));
+	}
+
+	// Snap to ground WITHOUT inheriting surface rotation (keeps world up)
+	bool SnapSelectedToGroundNoRotation()
+	{
+		return SnapSelection(false, TEXT("Snap to Ground (No Rotation)"));
+	}
+
+	bool SnapSelection(bool bAlignToSurface, const TCHAR* TransactionName)
 	{
 		if (!GEditor)
 		{
@@ -255,298 +249,69 @@ private:
 			return false;
 		}
 
-		// Create undo transaction
-		FScopedTransaction Transaction(FText::FromString(TEXT("Snap to Ground")));
+		// Still collecting results from the previous batch
+		if (SnapBatch.IsValid())
+		{
+			return true;
+		}
 
-		int32 NumModified = 0;
+		TArray<AActor*> Actors;
+		Actors.Reserve(Selection->Num());
 		for (int32 i = 0; i < Selection->Num(); i++)
 		{
-			AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i));
-			if (!Actor)
-			{
-				continue;
-			}
-
-			FVector ActorLocation = Actor->GetActorLocation();
-
-			// Get mesh component's LOCAL bounds (not affected by animation bloat)
-			// This gives us the actual mesh geometry bounds
-			float MeshBottomOffset = 0.0f; // Distance from actor origin to mesh bottom
-
-			if (USkeletalMeshComponent* SkelMesh = Actor->FindComponentByClass<USkeletalMeshComponent>())
-			{
-				FBoxSphereBounds LocalBounds = SkelMesh->CalcLocalBounds();
-				FVector LocalBottom = FVector(0, 0, LocalBounds.Origin.Z - LocalBounds.BoxExtent.Z);
-				FVector WorldBottom = SkelMesh->GetComponentTransform().TransformPosition(LocalBottom);
-				MeshBottomOffset = ActorLocation.Z - WorldBottom.Z;
-			}
-			else if (UStaticMeshComponent* StaticMesh = Actor->FindComponentByClass<UStaticMeshComponent>())
-			{
-				FBoxSphereBounds LocalBounds = StaticMesh->CalcLocalBounds();
-				FVector LocalBottom = FVector(0, 0, LocalBounds.Origin.Z - LocalBounds.BoxExtent.Z);
-				FVector WorldBottom = StaticMesh->GetComponentTransform().TransformPosition(LocalBottom);
-				MeshBottomOffset = ActorLocation.Z - WorldBottom.Z;
-			}
-			else
-			{
-				// Find first primitive component with blocking collision (skip query-only spheres, triggers, etc.)
-				UPrimitiveComponent* BestComp = nullptr;
-				TArray<UPrimitiveComponent*> PrimComps;
-				Actor->GetComponents<UPrimitiveComponent>(PrimComps);
-				for (UPrimitiveComponent* Comp : PrimComps)
-				{
-					ECollisionEnabled::Type ColType = Comp->GetCollisionEnabled();
-					if (ColType == ECollisionEnabled::QueryAndPhysics || ColType == ECollisionEnabled::PhysicsOnly)
-					{
-						BestComp = Comp;
-						break;
-					}
-				}
-
-				if (BestComp)
-				{
-					FBoxSphereBounds LocalBounds = BestComp->CalcLocalBounds();
-					FVector LocalBottom = FVector(0, 0, LocalBounds.Origin.Z - LocalBounds.BoxExtent.Z);
-					FVector WorldBottom = BestComp->GetComponentTransform().TransformPosition(LocalBottom);
-					MeshBottomOffset = ActorLocation.Z - WorldBottom.Z;
-				}
-				// else: no physics collision component, use 0 offset (root = ground)
-			}
-
-			// Line trace from actor position downward
-			FVector TraceStart = ActorLocation + FVector(0, 0, 500.f);
-			FVector TraceEnd = TraceStart - FVector(0, 0, 200000.f);
-
-			FCollisionQueryParams QueryParams;
-			QueryParams.AddIgnoredActor(Actor);
-
-			// Recursively ignore all attached actors
-			TArray<AActor*> AttachedActors;
-			Actor->GetAttachedActors(AttachedActors, true, true);
-			for (AActor* Attached : AttachedActors)
-			{
-				QueryParams.AddIgnoredActor(Attached);
-			}
-
-			FHitResult HitResult;
-			bool bHit = false;
-
-			// Use channel trace (ECC_Visibility) - respects collision responses,
-			// so query-only/overlap components are automatically skipped
-			for (int32 Attempt = 0; Attempt < 50; Attempt++)
+			if (AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i)))
 			{
-				bHit = World->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_Visibility, QueryParams);
-				if (!bHit)
-				{
-					break;
-				}
-
-				// Also skip components with query-only collision (blocks Visibility but no physics)
-				UPrimitiveComponent* HitComp = HitResult.GetComponent();
-				if (HitComp)
-				{
-					ECollisionEnabled::Type CollisionType = HitComp->GetCollisionEnabled();
-					if (CollisionType == ECollisionEnabled::QueryAndPhysics || CollisionType == ECollisionEnabled::PhysicsOnly)
-					{
-						break; // Valid collidable surface
-					}
-				}
-
-				// Skip this specific component and trace again
-				if (HitComp)
-				{
-					QueryParams.AddIgnoredComponent(HitComp);
-				}
-				bHit = false;
-			}
-
-			if (bHit)
-			{
-				Actor->Modify();
-
-				FVector NewLocation = ActorLocation;
-				NewLocation.Z = HitResult.ImpactPoint.Z + MeshBottomOffset + 5.0f;
-
-				Actor->SetActorLocation(NewLocation);
-
-				// Align actor rotation to surface normal (inherit slope)
-				// Keep the actor's current facing direction but tilt to match surface
-				FVector SurfaceNormal = HitResult.ImpactNormal;
-				FRotator CurrentRotation = Actor->GetActorRotation();
-
-				// Get actor's current forward direction (on XY plane)
-				FVector CurrentForward = CurrentRotation.Vector();
-				CurrentForward.Z = 0;
-				CurrentForward.Normalize();
-
-				// Build a rotation matrix from surface normal and desired forward
-				// NewUp = surface normal
-				// NewForward = project current forward onto the surface plane
-				FVector NewUp = SurfaceNormal;
-				FVector NewRight = FVector::CrossProduct(NewUp, CurrentForward);
-				NewRight.Normalize();
-				FVector NewForward = FVector::CrossProduct(NewRight, NewUp);
-				NewForward.Normalize();
-
-				// Build rotation from these axes
-				FMatrix RotationMatrix = FMatrix::Identity;
-				RotationMatrix.SetAxes(&NewForward, &NewRight, &NewUp);
-				FRotator AlignedRotation = RotationMatrix.Rotator();
-
-				Actor->SetActorRotation(AlignedRotation);
-				Actor->PostEditMove(true);
-
-				NumModified++;
+				Actors.Add(Actor);
 			}
 		}
 
-		if (NumModified > 0)
-		{
-			GEditor->NoteSelectionChange();
-			GEditor->RedrawLevelEditingViewports();
-			return true;
-		}
-
-		return false;
-	}
-
-	// Snap to ground WITHOUT inheriting surface rotation (keeps world up)
-	bool SnapSelectedToGroundNoRotation()
-	{
-		if (!GEditor)
+		// Large selections trace through the async queue over the next frames
+		const int32 AsyncThreshold = CVarAsyncSnapThreshold.GetValueOnGameThread();
+		if (AsyncThreshold > 0 && Actors.Num() >= AsyncThreshold)
 		{
+			TSharedRef<FGroundSnapBatch> Batch = MakeShared<FGroundSnapBatch>();
+			if (Batch->Start(World, Actors, bAlignToSurface, FText::FromString(TransactionName)))
+			{
+				SnapBatch = Batch;
+				return true;
+			}
 			return false;
 		}
 
-		USelection* Selection = GEditor->GetSelectedActors();
-		if (!Selection || Selection->Num() == 0)
-		{
-			return false;
-		}
+		// Snap bottom-up so actors resting on other selected actors land on their snapped positions
+		TArray<int32> Layers;
+		const int32 NumLayers = GroundSnap::BuildSupportLayers(Actors, Layers);
 
-		UWorld* World = GEditor->GetEditorWorldContext().World();
-		if (!World)
+		GroundSnap::FActorSet PendingActors;
+		PendingActors.Reserve(Actors.Num());
+		for (AActor* Actor : Actors)
 		{
-			return false;
+			PendingActors.Add(Actor);
 		}
 
+		// Bottom layer samples may come from the height cache or landscape instead of physics
+		GroundSnap::FGroundSources Sources;
+		GroundSnap::PrepareGroundSources(World, Actors, Sources);
+
 		// Create undo transaction
-		FScopedTransaction Transaction(FText::FromString(TEXT("Snap to Ground (No Rotation)")));
+		FScopedTransaction Transaction(FText::FromString(TransactionName));
 
 		int32 NumModified = 0;
-		for (int32 i = 0; i < Selection->Num(); i++)
+		for (int32 Layer = 0; Layer < NumLayers; Layer++)
 		{
-			AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i));
-			if (!Actor)
-			{
-				continue;
-			}
-
-			FVector ActorLocation = Actor->GetActorLocation();
-
-			// Get mesh component's LOCAL bounds (not affected by animation bloat)
-			float MeshBottomOffset = 0.0f;
-
-			if (USkeletalMeshComponent* SkelMesh = Actor->FindComponentByClass<USkeletalMeshComponent>())
-			{
-				FBoxSphereBounds LocalBounds = SkelMesh->CalcLocalBounds();
-				FVector LocalBottom = FVector(0, 0, LocalBounds.Origin.Z - LocalBounds.BoxExtent.Z);
-				FVector WorldBottom = SkelMesh->GetComponentTransform().TransformPosition(LocalBottom);
-				MeshBottomOffset = ActorLocation.Z - WorldBottom.Z;
-			}
-			else if (UStaticMeshComponent* StaticMesh = Actor->FindComponentByClass<UStaticMeshComponent>())
-			{
-				FBoxSphereBounds LocalBounds = StaticMesh->CalcLocalBounds();
-				FVector LocalBottom = FVector(0, 0, LocalBounds.Origin.Z - LocalBounds.BoxExtent.Z);
-				FVector WorldBottom = StaticMesh->GetComponentTransform().TransformPosition(LocalBottom);
-				MeshBottomOffset = ActorLocation.Z - WorldBottom.Z;
-			}
-			else
+			for (int32 i = 0; i < Actors.Num(); i++)
 			{
-				// Find first primitive component with blocking collision (skip query-only spheres, triggers, etc.)
-				UPrimitiveComponent* BestComp = nullptr;
-				TArray<UPrimitiveComponent*> PrimComps;
-				Actor->GetComponents<UPrimitiveComponent>(PrimComps);
-				for (UPrimitiveComponent* Comp : PrimComps)
-				{
-					ECollisionEnabled::Type ColType = Comp->GetCollisionEnabled();
-					if (ColType == ECollisionEnabled::QueryAndPhysics || ColType == ECollisionEnabled::PhysicsOnly)
-					{
-						BestComp = Comp;
-						break;
-					}
-				}
-
-				if (BestComp)
+				if (Layers[i] == Layer && GroundSnap::SnapActor(World, Actors[i], bAlignToSurface, &PendingActors, Layer == 0 ? &Sources : nullptr))
 				{
-					FBoxSphereBounds LocalBounds = BestComp->CalcLocalBounds();
-					FVector LocalBottom = FVector(0, 0, LocalBounds.Origin.Z - LocalBounds.BoxExtent.Z);
-					FVector WorldBottom = BestComp->GetComponentTransform().TransformPosition(LocalBottom);
-					MeshBottomOffset = ActorLocation.Z - WorldBottom.Z;
+					NumModified++;
 				}
-				// else: no physics collision component, use 0 offset (root = ground)
-			}
-
-			// Line trace from actor position downward
-			FVector TraceStart = ActorLocation + FVector(0, 0, 500.f);
-			FVector TraceEnd = TraceStart - FVector(0, 0, 200000.f);
-
-			FCollisionQueryParams QueryParams;
-			QueryParams.AddIgnoredActor(Actor);
-
-			// Recursively ignore all attached actors
-			TArray<AActor*> AttachedActors;
-			Actor->GetAttachedActors(AttachedActors, true, true);
-			for (AActor* Attached : AttachedActors)
-			{
-				QueryParams.AddIgnoredActor(Attached);
 			}
-
-			FHitResult HitResult;
-			bool bHit = false;
-
-			// Use channel trace (ECC_Visibility) - respects collision responses,
-			// so query-only/overlap components are automatically skipped
-			for (int32 Attempt = 0; Attempt < 50; Attempt++)
+			for (int32 i = 0; i < Actors.Num(); i++)
 			{
-				bHit = World->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_Visibility, QueryParams);
-				if (!bHit)
-				{
-					break;
-				}
-
-				// Also skip components with query-only collision (blocks Visibility but no physics)
-				UPrimitiveComponent* HitComp = HitResult.GetComponent();
-				if (HitComp)
-				{
-					ECollisionEnabled::Type CollisionType = HitComp->GetCollisionEnabled();
-					if (CollisionType == ECollisionEnabled::QueryAndPhysics || CollisionType == ECollisionEnabled::PhysicsOnly)
-					{
-						break; // Valid collidable surface
-					}
-				}
-
-				// Skip this specific component and trace again
-				if (HitComp)
+				if (Layers[i] == Layer)
 				{
-					QueryParams.AddIgnoredComponent(HitComp);
+					PendingActors.Remove(Actors[i]);
 				}
-				bHit = false;
-			}
-
-			if (bHit)
-			{
-				Actor->Modify();
-
-				FVector NewLocation = ActorLocation;
-				NewLocation.Z = HitResult.ImpactPoint.Z + MeshBottomOffset + 5.0f;
-
-				Actor->SetActorLocation(NewLocation);
-				// Reset rotation to 0,0,0 (world up, no rotation)
-				Actor->SetActorRotation(FRotator::ZeroRotator);
-				Actor->PostEditMove(true);
-
-				NumModified++;
 			}
 		}
 
@@ -573,49 +338,16 @@ private:
 			return false;
 		}
 
-		// Store original transforms before duplication
-		TArray<FTransform> OriginalTransforms;
-		for (int32 i = 0; i < Selection->Num(); i++)
-		{
-			if (AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i)))
-			{
-				OriginalTransforms.Add(Actor->GetActorTransform());
-			}
-		}
-
-		if (OriginalTransforms.Num() == 0)
-		{
-			return false;
-		}
-
-		// Execute the standard duplicate command
-		GEditor->Exec(GEditor->GetEditorWorldContext().World(), TEXT("DUPLICATE"));
-
-		// The duplicated actors are now selected - move them back to original positions
-		Selection = GEditor->GetSelectedActors();
-		if (Selection && Selection->Num() == OriginalTransforms.Num())
-		{
-			FScopedTransaction Transaction(FText::FromString(TEXT("Duplicate In Place")));
-
-			for (int32 i = 0; i < Selection->Num(); i++)
-			{
-				if (AActor* Actor = Cast<AActor>(Selection->GetSelectedObject(i)))
-				{
-					Actor->Modify();
-					Actor->SetActorTransform(OriginalTransforms[i]);
-					Actor->PostEditMove(true);
-				}
-			}
-
-			GEditor->NoteSelectionChange();
-			GEditor->RedrawLevelEditingViewports();
-		}
+		TArray<AActor*> Actors;
+		Selection->GetSelectedObjects<AActor>(Actors);
 
-		return true;
+		// Clones straight at the original transforms in one transaction (DUPLICATE command for brushes/groups)
+		return ActorDuplication::DuplicateInPlace(Actors);
 	}
 
-	// Called when Ctrl+Shift+V is pressed - sets up deferred paste
-	bool SetupPasteToFolder()
+	// Paste through the editor's paste command and move the pasted actors into the folder of the
+	// first selected actor - same frame, one transaction, no OS input round trip
+	bool PasteToFolder()
 	{
 		if (!GEditor)
 		{
@@ -629,7 +361,7 @@ private:
 		}
 
 		// Get folder path from currently selected actor
-		PendingPasteFolderPath = NAME_None;
+		FName FolderPath = NAME_None;
 
 		USelection* ActorSelection = GEditor->GetSelectedActors();
 		if (ActorSelection)
@@ -638,78 +370,45 @@ private:
 			{
 				if (AActor* Actor = Cast<AActor>(ActorSelection->GetSelectedObject(i)))
 				{
-					PendingPasteFolderPath = Actor->GetFolderPath();
+					FolderPath = Actor->GetFolderPath();
 					break;
 				}
 			}
 		}
 
-		// Store all actors currently in the world
-		ActorsBeforePaste.Empty();
-		for (TActorIterator<AActor> It(World); It; ++It)
-		{
-			ActorsBeforePaste.Add(*It);
-		}
-
-		// Mark that we're waiting for paste to complete
-		bPasteToFolderPending = true;
-
-		// Return false to NOT consume the event - let normal Ctrl+V paste happen
-		return false;
-	}
-
-	// Called on next tick after paste - moves actors to folder
-	void CompletePasteToFolder()
-	{
-		if (!GEditor)
-		{
-			return;
-		}
-
-		UWorld* World = GEditor->GetEditorWorldContext().World();
-		if (!World)
-		{
-			return;
-		}
+		// The paste's own transaction nests into this one, so paste + folder move undo together
+		FScopedTransaction Transaction(FText::FromString(TEXT("Paste to Folder")));
 
-		// Find newly created actors
-		TArray<AActor*> NewlyPastedActors;
-		for (TActorIterator<AActor> It(World); It; ++It)
+		// Collect what the paste spawns (cost scales with the paste, not the world)
+		TArray<AActor*> PastedActors;
 		{
-			if (!ActorsBeforePaste.Contains(*It))
-			{
-				NewlyPastedActors.Add(*It);
-			}
+			FScopedAddedActorCapture Capture;
+			GEditor->Exec(World, TEXT("EDIT PASTE"));
+			PastedActors = Capture.GetActors();
 		}
+		PastedActors.RemoveAll([World](const AActor* Actor) { return Actor->GetWorld() != World; });
 
-		ActorsBeforePaste.Empty();
-
-		// If no folder was specified or no new actors, we're done
-		if (PendingPasteFolderPath.IsNone() || NewlyPastedActors.Num() == 0)
+		if (PastedActors.Num() == 0)
 		{
-			return;
+			Transaction.Cancel();
+			return true;
 		}
 
-		// Move pasted actors to target folder
-		FScopedTransaction Transaction(FText::FromString(TEXT("Paste to Folder")));
-
-		for (AActor* Actor : NewlyPastedActors)
+		// Move pasted actors to target folder (one Outliner refresh for large pastes)
+		if (!FolderPath.IsNone())
 		{
-			Actor->Modify();
-			Actor->SetFolderPath(PendingPasteFolderPath);
+			FolderAssignment::MoveActorsToFolder(PastedActors, FolderPath);
 		}
 
 		GEditor->NoteSelectionChange();
 		GEditor->RedrawLevelEditingViewports();
+		return true;
 	}
 };
 
 TSharedPtr<FTransformCopyPasteProcessor> FTransformCopyPasteProcessor::Instance;
 FTransform FTransformCopyPasteProcessor::CopiedTransform;
 bool FTransformCopyPasteProcessor::bHasCopiedTransform = false;
-FName FTransformCopyPasteProcessor::PendingPasteFolderPath;
-TSet<AActor*> FTransformCopyPasteProcessor::ActorsBeforePaste;
-bool FTransformCopyPasteProcessor::bPasteToFolderPending = false;
 
 // Namespace for module registration
 namespace TransformCopyPaste
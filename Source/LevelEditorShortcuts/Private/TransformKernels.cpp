@@ -0,0 +1,167 @@
+// TransformKernels.cpp
+// VectorRegister implementations of the batch transform kernels, plus
+// LevelEditorShortcuts.BenchmarkTransformKernels to compare them against the scalar FVector/FQuat path.
+
+#include "TransformKernels.h"
+#include "LevelEditorShortcutsLog.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+namespace TransformKernels
+{
+	void Translate(TArrayView<const FVector> Locations, const FVector& Offset, TArrayView<FVector> OutLocations)
+	{
+		check(Locations.Num() == OutLocations.Num());
+
+		const VectorRegister4Double OffsetReg = VectorLoadFloat3_W0(&Offset.X);
+		for (int32 i = 0; i < Locations.Num(); i++)
+		{
+			VectorStoreFloat3(VectorAdd(VectorLoadFloat3(&Locations[i].X), OffsetReg), &OutLocations[i].X);
+		}
+	}
+
+	void ScaleClamped(TArrayView<const FVector> Scales, double Multiplier, double MinScale, TArrayView<FVector> OutScales)
+	{
+		check(Scales.Num() == OutScales.Num());
+
+		const VectorRegister4Double MultiplierReg = VectorSetFloat1(Multiplier);
+		const VectorRegister4Double MinScaleReg = VectorSetFloat1(MinScale);
+		for (int32 i = 0; i < Scales.Num(); i++)
+		{
+			const VectorRegister4Double Scaled = VectorMultiply(VectorLoadFloat3(&Scales[i].X), MultiplierReg);
+			VectorStoreFloat3(VectorMax(Scaled, MinScaleReg), &OutScales[i].X);
+		}
+	}
+
+	void TransformAboutPivot(TArrayView<FVector> Locations, TArrayView<FQuat> Rotations, const FVector& Pivot, const FQuat& Rotation, double Scale)
+	{
+		check(Locations.Num() == 0 || Rotations.Num() == 0 || Locations.Num() == Rotations.Num());
+
+		const VectorRegister4Double RotationReg = VectorLoad(&Rotation.X);
+
+		if (Locations.Num() > 0)
+		{
+			const VectorRegister4Double PivotReg = VectorLoadFloat3_W0(&Pivot.X);
+			const VectorRegister4Double ScaleReg = VectorSetFloat1(Scale);
+			for (int32 i = 0; i < Locations.Num(); i++)
+			{
+				// W must be zero for the quaternion rotate
+				VectorRegister4Double Relative = VectorSubtract(VectorLoadFloat3_W0(&Locations[i].X), PivotReg);
+				Relative = VectorQuaternionRotateVector(RotationReg, VectorMultiply(Relative, ScaleReg));
+				VectorStoreFloat3(VectorAdd(PivotReg, Relative), &Locations[i].X);
+			}
+		}
+
+		for (int32 i = 0; i < Rotations.Num(); i++)
+		{
+			VectorStore(VectorQuaternionMultiply2(RotationReg, VectorLoad(&Rotations[i].X)), &Rotations[i].X);
+		}
+	}
+
+	float MinDotProduct(TConstArrayView<FVector3f> Points, const FVector3f& Direction)
+	{
+		const VectorRegister4Float DirectionReg = VectorLoadFloat3_W0(&Direction.X);
+
+		// Four independent accumulators so the dot products don't serialize on one min
+		VectorRegister4Float Min0 = VectorSetFloat1(MAX_flt);
+		VectorRegister4Float Min1 = Min0;
+		VectorRegister4Float Min2 = Min0;
+		VectorRegister4Float Min3 = Min0;
+
+		const int32 Num = Points.Num();
+		int32 i = 0;
+		for (; i + 4 <= Num; i += 4)
+		{
+			Min0 = VectorMin(Min0, VectorDot3(VectorLoadFloat3(&Points[i + 0].X), DirectionReg));
+			Min1 = VectorMin(Min1, VectorDot3(VectorLoadFloat3(&Points[i + 1].X), DirectionReg));
+			Min2 = VectorMin(Min2, VectorDot3(VectorLoadFloat3(&Points[i + 2].X), DirectionReg));
+			Min3 = VectorMin(Min3, VectorDot3(VectorLoadFloat3(&Points[i + 3].X), DirectionReg));
+		}
+		for (; i < Num; i++)
+		{
+			Min0 = VectorMin(Min0, VectorDot3(VectorLoadFloat3(&Points[i].X), DirectionReg));
+		}
+
+		return VectorGetComponent(VectorMin(VectorMin(Min0, Min1), VectorMin(Min2, Min3)), 0);
+	}
+
+	TConstArrayView<int32> GetBenchmarkActorCounts()
+	{
+		static const int32 ActorCounts[] = { 1000, 10000, 100000 };
+		return ActorCounts;
+	}
+
+	double TimeBenchmarkMs(TFunctionRef<void()> Work)
+	{
+		constexpr int32 NumIterations = 20;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			Work();
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+	}
+}
+
+// LevelEditorShortcuts.BenchmarkTransformKernels - kernels vs the scalar per-actor math they replace
+static void RunTransformKernelBenchmark()
+{
+	using TransformKernels::TimeBenchmarkMs;
+
+	for (int32 NumActors : TransformKernels::GetBenchmarkActorCounts())
+	{
+		TArray<FVector> Locations;
+		TArray<FQuat> Rotations;
+		TArray<FVector> OutLocations;
+		Locations.SetNumUninitialized(NumActors);
+		Rotations.SetNumUninitialized(NumActors);
+		OutLocations.SetNumUninitialized(NumActors);
+		for (int32 i = 0; i < NumActors; i++)
+		{
+			Locations[i] = FMath::VRand() * FMath::FRandRange(0.0f, 100000.0f);
+			Rotations[i] = FRotator(0.0f, FMath::FRandRange(-180.0f, 180.0f), 0.0f).Quaternion();
+		}
+
+		const FVector Offset(10.0, -20.0, 5.0);
+		const FVector Pivot(500.0, 250.0, 0.0);
+		const FQuat Rotation(FVector::UpVector, FMath::DegreesToRadians(15.0));
+		const double Scale = 1.001;
+
+		const double TranslateScalar = TimeBenchmarkMs([&]()
+		{
+			for (int32 i = 0; i < NumActors; i++)
+			{
+				OutLocations[i] = Locations[i] + Offset;
+			}
+		});
+		const double TranslateKernel = TimeBenchmarkMs([&]() { TransformKernels::Translate(Locations, Offset, OutLocations); });
+
+		const double RotateScalar = TimeBenchmarkMs([&]()
+		{
+			for (int32 i = 0; i < NumActors; i++)
+			{
+				Locations[i] = Pivot + Rotation.RotateVector(Locations[i] - Pivot);
+				Rotations[i] = Rotation * Rotations[i];
+			}
+		});
+		const double RotateKernel = TimeBenchmarkMs([&]() { TransformKernels::RotateAboutPivot(Locations, Rotations, Pivot, Rotation); });
+
+		const double ScaleScalar = TimeBenchmarkMs([&]()
+		{
+			for (int32 i = 0; i < NumActors; i++)
+			{
+				Locations[i] = Pivot + (Locations[i] - Pivot) * Scale;
+			}
+		});
+		const double ScaleKernel = TimeBenchmarkMs([&]() { TransformKernels::ScaleAboutPivot(Locations, Pivot, Scale); });
+
+		UE_LOG(LogLevelEditorShortcuts, Display, TEXT("%6d actors: translate %.3f -> %.3f ms, rotate about pivot %.3f -> %.3f ms, scale about pivot %.3f -> %.3f ms (scalar -> kernel)"),
+			NumActors, TranslateScalar, TranslateKernel, RotateScalar, RotateKernel, ScaleScalar, ScaleKernel);
+	}
+}
+
+static FAutoConsoleCommand BenchmarkTransformKernelsCommand(
+	TEXT("LevelEditorShortcuts.BenchmarkTransformKernels"),
+	TEXT("Times the batch transform kernels against scalar FVector/FQuat math for 1k-100k synthetic actors."),
+	FConsoleCommandDelegate::CreateStatic(&RunTransformKernelBenchmark));
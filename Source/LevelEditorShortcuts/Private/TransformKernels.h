@@ -0,0 +1,44 @@
+// TransformKernels.h
+// Batch transform kernels shared by the shortcut processors.
+// Each kernel applies one translation / rotation / similarity transform to N actors stored
+// as structure-of-arrays (parallel location, rotation and scale arrays) using VectorRegister math.
+// Views are plain arrays - callers slice them to run batches on worker threads.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+namespace TransformKernels
+{
+	// OutLocations[i] = Locations[i] + Offset
+	void Translate(TArrayView<const FVector> Locations, const FVector& Offset, TArrayView<FVector> OutLocations);
+
+	// OutScales[i] = Max(Scales[i] * Multiplier, MinScale) per component
+	void ScaleClamped(TArrayView<const FVector> Scales, double Multiplier, double MinScale, TArrayView<FVector> OutScales);
+
+	// Similarity transform about Pivot, in place:
+	//   Locations[i] = Pivot + Rotation * ((Locations[i] - Pivot) * Scale)
+	//   Rotations[i] = Rotation * Rotations[i]
+	// Either view may be empty to leave that array untouched; otherwise both must be the same size.
+	void TransformAboutPivot(TArrayView<FVector> Locations, TArrayView<FQuat> Rotations, const FVector& Pivot, const FQuat& Rotation, double Scale);
+
+	// Min over i of Dot(Points[i], Direction) - the support distance of a point cloud (e.g. mesh vertices)
+	// along -Direction. Returns MAX_flt for an empty view.
+	float MinDotProduct(TConstArrayView<FVector3f> Points, const FVector3f& Direction);
+
+	inline void RotateAboutPivot(TArrayView<FVector> Locations, TArrayView<FQuat> Rotations, const FVector& Pivot, const FQuat& Rotation)
+	{
+		TransformAboutPivot(Locations, Rotations, Pivot, Rotation, 1.0);
+	}
+
+	inline void ScaleAboutPivot(TArrayView<FVector> Locations, const FVector& Pivot, double Scale)
+	{
+		TransformAboutPivot(Locations, TArrayView<FQuat>(), Pivot, FQuat::Identity, Scale);
+	}
+
+	// Shared by the transform math benchmarks: the synthetic selection sizes they run at (1k-100k),
+	// and the average time of Work over a fixed number of runs in ms
+	TConstArrayView<int32> GetBenchmarkActorCounts();
+	double TimeBenchmarkMs(TFunctionRef<void()> Work);
+}